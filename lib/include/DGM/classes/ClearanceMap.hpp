@@ -0,0 +1,109 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Clearance of every tile of a mesh
+     *
+     *  Clearance of a tile is the size of the largest square of passable
+     * tiles that has the tile as its top left corner. Impassable tiles have
+     * zero clearance.
+     *
+     *  Agent spanning N by N tiles fits at a tile if the clearance of the
+     * tile is at least N, with the tile being the top left tile of the
+     * agent. This lets a single mesh serve agents of all sizes instead of
+     * keeping an eroded copy of the mesh for each of them.
+     *
+     *  Values are capped at MAX_CLEARANCE, which is much more than any
+     * agent needs.
+     */
+    class [[nodiscard]] ClearanceMap final
+    {
+    public:
+        static constexpr unsigned MAX_CLEARANCE = 255;
+
+    public:
+        explicit ClearanceMap(const dgm::Mesh& mesh);
+
+        ClearanceMap(ClearanceMap&&) = default;
+        ClearanceMap(const ClearanceMap&) = delete;
+
+        ClearanceMap& operator=(ClearanceMap&&) = default;
+        ClearanceMap& operator=(const ClearanceMap&) = delete;
+
+    public:
+        /**
+         *  \brief Update clearance after some tiles of the mesh changed
+         *
+         *  Only tiles above and to the left of the changed ones, at most
+         * MAX_CLEARANCE tiles away, are computed again.
+         *
+         *  \param topLeft Top left corner of inclusive rectangle containing
+         * all changed tiles
+         *  \param bottomRight Bottom right corner of the rectangle
+         */
+        void update(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight);
+
+        /**
+         *  \brief Update clearance after a single tile of the mesh changed
+         */
+        void update(const dgm::Mesh& mesh, const sf::Vector2u& tile)
+        {
+            update(mesh, tile, tile);
+        }
+
+        [[nodiscard]] unsigned
+        getClearance(const sf::Vector2u& tile) const noexcept
+        {
+            return clearance[tile.y * dataSize.x + tile.x];
+        }
+
+        /**
+         *  \brief Test whether an agent spanning agentSize by agentSize
+         * tiles fits at a tile, which is its top left tile
+         */
+        [[nodiscard]] bool
+        canFit(const sf::Vector2u& tile, unsigned agentSize) const noexcept
+        {
+            return getClearance(tile) >= agentSize;
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+        /**
+         *  \brief Version of the mesh the clearance was computed from
+         */
+        [[nodiscard]] constexpr const MeshVersion&
+        getMeshVersion() const noexcept
+        {
+            return meshVersion;
+        }
+
+    private:
+        /**
+         *  \brief Compute clearance of all tiles in a rectangle, tiles
+         * below and to the right of it must be up to date
+         */
+        void computeClearance(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight);
+
+    private:
+        sf::Vector2u dataSize;
+        MeshVersion meshVersion;
+        std::vector<std::uint8_t> clearance = {};
+    };
+} // namespace dgm
@@ -1,11 +1,103 @@
 #pragma once
 
 #include <DGM/classes/Objects.hpp>
+#include <DGM/classes/OccupancyMesh.hpp>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace dgm
 {
     class Collision
     {
+    public:
+        /**
+         *  \brief Many circles stored in structure of arrays layout
+         *
+         *  Batch tests process several circles per instruction thanks to
+         * this layout. All spans must have the same size.
+         */
+        struct CircleBatch
+        {
+            /// X coordinates of the centers
+            std::span<const float> x;
+            /// Y coordinates of the centers
+            std::span<const float> y;
+            std::span<const float> radius;
+
+            [[nodiscard]] constexpr std::size_t size() const noexcept
+            {
+                return x.size();
+            }
+        };
+
+        /**
+         *  \brief Many rectangles stored in structure of arrays layout
+         *
+         *  All spans must have the same size.
+         */
+        struct RectBatch
+        {
+            /// X coordinates of the top left corners
+            std::span<const float> x;
+            /// Y coordinates of the top left corners
+            std::span<const float> y;
+            std::span<const float> width;
+            std::span<const float> height;
+
+            [[nodiscard]] constexpr std::size_t size() const noexcept
+            {
+                return x.size();
+            }
+        };
+
+        /// Number of shapes whose results share one word of a hit mask
+        static constexpr std::size_t HIT_MASK_WORD_BITS = 64;
+
+        /**
+         *  \brief Get number of words of a hit mask for a batch of given
+         * size
+         */
+        [[nodiscard]] static constexpr std::size_t
+        getHitMaskSize(std::size_t batchSize) noexcept
+        {
+            return (batchSize + HIT_MASK_WORD_BITS - 1) / HIT_MASK_WORD_BITS;
+        }
+
+        /**
+         *  \brief Contact of a moving body with impassable tiles of a mesh
+         */
+        struct MeshContact
+        {
+            /// Forward vector with blocked axes zeroed, same as advanced
+            /// computes it
+            sf::Vector2f forward;
+            bool blockedX;
+            bool blockedY;
+            /// How deep the body would get into the walls if moved by the
+            /// original forward vector
+            float penetration;
+            /// Unit normal of the deepest contact, pointing out of the wall
+            sf::Vector2f normal;
+            /// Index of the first tile hit by the original movement
+            std::size_t meshHitPosition;
+        };
+
+        /**
+         *  \brief First impassable tile of a mesh hit by a moving body
+         */
+        struct SweepHit
+        {
+            /// Fraction of the forward vector travelled before the hit,
+            /// between 0 and 1
+            float time;
+            /// Unit normal of the hit surface, pointing out of the wall.
+            /// Zero if the body overlaps the wall from the start.
+            sf::Vector2f normal;
+            std::size_t meshHitPosition;
+        };
+
     public:
         /**
          * 	\brief Tests collision between a rectangle and a point
@@ -76,6 +168,16 @@ namespace dgm
          */
         static bool basic(const dgm::Rect& A, const dgm::Circle& B);
 
+        /**
+         * 	\brief Tests collision between a circle and a rectange
+         *
+         * 	\return TRUE if collision was detected. FALSE otherwise
+         */
+        static bool basic(const dgm::Circle& A, const dgm::Rect& B)
+        {
+            return basic(B, A);
+        }
+
         /**
          * 	\brief Tests collision between two rectangles
          *
@@ -112,6 +214,32 @@ namespace dgm
             const dgm::Rect& B,
             std::size_t* meshHitPosition = nullptr);
 
+        /**
+         *  \brief Tests collision between packed mesh and a circle
+         *
+         *  Same as the dgm::Mesh overload, but empty tiles are skipped
+         * up to 64 at a time.
+         *
+         *  \return TRUE if collision was detected. FALSE otherwise
+         */
+        static bool basic(
+            const dgm::OccupancyMesh& A,
+            const dgm::Circle& B,
+            std::size_t* meshHitPosition = nullptr);
+
+        /**
+         *  \brief Tests collision between packed mesh and a rectangle
+         *
+         *  Same as the dgm::Mesh overload, but each row of tiles covered by
+         * the rectangle is tested by a few word-wide masks.
+         *
+         *  \return TRUE if collision was detected. FALSE otherwise
+         */
+        static bool basic(
+            const dgm::OccupancyMesh& A,
+            const dgm::Rect& B,
+            std::size_t* meshHitPosition = nullptr);
+
         /**
          * \brief Detect presense of a circle within a vision cone
          */
@@ -182,6 +310,106 @@ namespace dgm
          */
         static bool basic(const dgm::Rect& r, const dgm::VisionCone& cone);
 
+        /**
+         *  \brief Tests collision between a circle and each circle of a batch
+         *
+         *  Gives the same results as calling basic for every pair, but the
+         * loop is branchless and gets vectorized by the compiler.
+         *
+         *  \param hits Bitmask with bit i % HIT_MASK_WORD_BITS of word
+         * i / HIT_MASK_WORD_BITS set if i-th circle of the batch collides.
+         * Bits past the end of the batch are cleared. Must have at least
+         * getHitMaskSize(batch.size()) words.
+         */
+        static void basic(
+            const dgm::Circle& circle,
+            const CircleBatch& batch,
+            std::span<std::uint64_t> hits);
+
+        /**
+         *  \brief Tests collision between a circle and each rectangle of
+         * a batch
+         *
+         *  \see basic(const dgm::Circle&, const CircleBatch&, std::span)
+         */
+        static void basic(
+            const dgm::Circle& circle,
+            const RectBatch& batch,
+            std::span<std::uint64_t> hits);
+
+        /**
+         *  \brief Tests collision between a rectangle and each circle of
+         * a batch
+         *
+         *  \see basic(const dgm::Circle&, const CircleBatch&, std::span)
+         */
+        static void basic(
+            const dgm::Rect& rect,
+            const CircleBatch& batch,
+            std::span<std::uint64_t> hits);
+
+        /**
+         *  \brief Tests collision between a rectangle and each rectangle of
+         * a batch
+         *
+         *  \see basic(const dgm::Circle&, const CircleBatch&, std::span)
+         */
+        static void basic(
+            const dgm::Rect& rect,
+            const RectBatch& batch,
+            std::span<std::uint64_t> hits);
+
+        /**
+         *  \brief Find indices of all circles of a batch colliding with
+         * a circle
+         *
+         *  Typical narrow phase after querying a spatial index. Indices are
+         * appended in ascending order, so the vector can be reused between
+         * queries without any allocations once it grows big enough.
+         *
+         *  \return Number of appended indices
+         */
+        static std::size_t collectHits(
+            const dgm::Circle& circle,
+            const CircleBatch& batch,
+            std::vector<std::size_t>& hitIndices);
+
+        /**
+         *  \brief Find indices of all rectangles of a batch colliding with
+         * a circle
+         *
+         *  \see collectHits(const dgm::Circle&, const CircleBatch&,
+         * std::vector&)
+         */
+        static std::size_t collectHits(
+            const dgm::Circle& circle,
+            const RectBatch& batch,
+            std::vector<std::size_t>& hitIndices);
+
+        /**
+         *  \brief Find indices of all circles of a batch colliding with
+         * a rectangle
+         *
+         *  \see collectHits(const dgm::Circle&, const CircleBatch&,
+         * std::vector&)
+         */
+        static std::size_t collectHits(
+            const dgm::Rect& rect,
+            const CircleBatch& batch,
+            std::vector<std::size_t>& hitIndices);
+
+        /**
+         *  \brief Find indices of all rectangles of a batch colliding with
+         * a rectangle
+         *
+         *  \see collectHits(const dgm::Circle&, const CircleBatch&,
+         * std::vector&)
+         */
+        static std::size_t collectHits(
+            const dgm::Rect& rect,
+            const RectBatch& batch,
+            std::vector<std::size_t>& hitIndices);
+
         /**
          *  \brief Elaborates movement of an object within a mesh
          *
@@ -206,6 +434,65 @@ namespace dgm
             sf::Vector2f& forward,
             std::size_t* meshHitPosition = nullptr);
 
+        /**
+         *  \brief Find contact of a body moving within a mesh
+         *
+         *  Tiles the movement can touch are scanned just once, testing the
+         * full movement and the movements along each axis together. Blocked
+         * axes are the same as advanced finds, besides them the contact
+         * provides penetration depth and normal for sliding along the walls.
+         *
+         *  \return Empty optional if the movement is not blocked at all
+         */
+        [[nodiscard]] static std::optional<MeshContact> resolve(
+            const dgm::Mesh& mesh,
+            const dgm::Circle& body,
+            const sf::Vector2f& forward);
+
+        /**
+         *  \brief Find contact of a body moving within a mesh
+         *
+         *  \see resolve(const dgm::Mesh&, const dgm::Circle&,
+         * const sf::Vector2f&)
+         */
+        [[nodiscard]] static std::optional<MeshContact> resolve(
+            const dgm::Mesh& mesh,
+            const dgm::Rect& body,
+            const sf::Vector2f& forward);
+
+        /**
+         *  \brief Find the first wall a body hits while moving by the whole
+         * forward vector
+         *
+         *  Unlike advanced, which only tests where the movement ends, the
+         * whole path of the body is tested, so fast bodies cannot pass
+         * through thin walls. Tiles are visited in the order the bounding
+         * box of the body enters them, like a raycaster visits them, so the
+         * cost grows with the length of the path, not with the number of
+         * tiles of the mesh.
+         *
+         *  Body moved by forward * time touches the wall, but does not
+         * overlap it. Tiles outside of the mesh are passable.
+         *
+         *  \return Empty optional if the body hits no wall
+         */
+        [[nodiscard]] static std::optional<SweepHit> sweep(
+            const dgm::Mesh& mesh,
+            const dgm::Circle& body,
+            const sf::Vector2f& forward);
+
+        /**
+         *  \brief Find the first wall a body hits while moving by the whole
+         * forward vector
+         *
+         *  \see sweep(const dgm::Mesh&, const dgm::Circle&,
+         * const sf::Vector2f&)
+         */
+        [[nodiscard]] static std::optional<SweepHit> sweep(
+            const dgm::Mesh& mesh,
+            const dgm::Rect& body,
+            const sf::Vector2f& forward);
+
         template<class T>
         static bool
         advanced(const dgm::Rect& anchor, T body, sf::Vector2f& forward);
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Labels of connected regions of passable tiles of a mesh
+     *
+     *  Two tiles share a component if there is a path between them made of
+     * horizontal and vertical steps over passable tiles. Since neither
+     * dgm::TileNavMesh nor dgm::WorldNavMesh cut corners of impassable
+     * tiles, diagonal movement never connects two different components.
+     *
+     *  Tiles in different components are unreachable from each other, which
+     * can be answered in O(1) instead of exhausting the whole reachable area
+     * by a failing search.
+     *
+     *  Call update whenever the mesh changes. Opening a passage merges
+     * components in near constant time, only placing walls requires the
+     * affected components to be labelled again.
+     */
+    class [[nodiscard]] ConnectedComponents final
+    {
+    public:
+        using ComponentId = std::uint32_t;
+
+        /// Component of impassable tiles
+        static constexpr ComponentId NO_COMPONENT =
+            std::numeric_limits<ComponentId>::max();
+
+    public:
+        explicit ConnectedComponents(const dgm::Mesh& mesh);
+
+        ConnectedComponents(ConnectedComponents&&) = default;
+        ConnectedComponents(const ConnectedComponents&) = delete;
+
+        ConnectedComponents& operator=(ConnectedComponents&&) = default;
+        ConnectedComponents& operator=(const ConnectedComponents&) = delete;
+
+    public:
+        /**
+         *  \brief Update components after some tiles of the mesh changed
+         *
+         *  \param topLeft Top left corner of inclusive rectangle containing
+         * all changed tiles
+         *  \param bottomRight Bottom right corner of the rectangle
+         */
+        void update(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight);
+
+        /**
+         *  \brief Update components after a single tile of the mesh changed
+         */
+        void update(const dgm::Mesh& mesh, const sf::Vector2u& tile)
+        {
+            update(mesh, tile, tile);
+        }
+
+        /**
+         *  \brief Get component of a tile
+         *
+         *  Ids are only meant to be compared with each other, they can
+         * change with every update.
+         *
+         *  \return NO_COMPONENT for impassable tiles
+         */
+        [[nodiscard]] ComponentId
+        getComponent(const sf::Vector2u& tile) const noexcept
+        {
+            const ComponentId label = tileLabels[tile.y * dataSize.x + tile.x];
+            return label == NO_COMPONENT ? NO_COMPONENT : labelRoots[label];
+        }
+
+        /**
+         *  \brief Test whether there is a path between two passable tiles
+         */
+        [[nodiscard]] bool areConnected(
+            const sf::Vector2u& a, const sf::Vector2u& b) const noexcept
+        {
+            const ComponentId component = getComponent(a);
+            return component != NO_COMPONENT && component == getComponent(b);
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+        /**
+         *  \brief Version of the mesh the components were computed from
+         */
+        [[nodiscard]] constexpr const MeshVersion&
+        getMeshVersion() const noexcept
+        {
+            return meshVersion;
+        }
+
+    private:
+        void labelAllTiles(const dgm::Mesh& mesh);
+
+        [[nodiscard]] ComponentId createLabel();
+
+        /**
+         *  \brief Assign a new label to all tiles connected to a tile
+         */
+        void flood(std::uint32_t tileIndex, ComponentId label);
+
+        [[nodiscard]] ComponentId findRoot(ComponentId label) const noexcept;
+
+        void unite(ComponentId a, ComponentId b) noexcept;
+
+    private:
+        sf::Vector2u dataSize;
+        MeshVersion meshVersion;
+
+        /// Label of every tile, NO_COMPONENT for impassable tiles
+        std::vector<ComponentId> tileLabels = {};
+
+        /**
+         *  \brief Union-find forest of labels
+         *
+         *  Labels of merged components point to a common root. Paths are
+         * fully compressed after every update, so each label points
+         * directly to its root outside of update.
+         */
+        std::vector<ComponentId> labelRoots = {};
+
+        /// Scratch memory for flood fills
+        std::vector<std::uint32_t> queue = {};
+    };
+} // namespace dgm
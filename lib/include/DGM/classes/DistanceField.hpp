@@ -0,0 +1,142 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <thread>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Signed distance to the nearest wall for every tile of a mesh
+     *
+     *  Distances are exact Euclidean distances between tile centers in
+     * world units, computed by the linear time algorithm of Felzenszwalb
+     * and Huttenlocher. They are shifted by half a tile, so the distance is
+     * zero on the boundary between passable and impassable tiles, positive
+     * in passable tiles and negative in impassable tiles.
+     *
+     *  Field can be sampled at any point of the world with bilinear
+     * interpolation between tile centers, which is handy for steering
+     * agents away from walls or for testing circles against the level with
+     * a single lookup.
+     *
+     *  Position and voxel size are copied from the mesh. The field is not
+     * updated with the mesh, build a new one when the mesh changes.
+     */
+    class [[nodiscard]] DistanceField final
+    {
+    public:
+        /**
+         *  \brief Compute distances for all tiles of a mesh
+         *
+         *  \param threadCount Number of threads the rows and columns of the
+         * mesh are split among. The result does not depend on it.
+         */
+        explicit DistanceField(
+            const dgm::Mesh& mesh,
+            unsigned threadCount = std::thread::hardware_concurrency());
+
+        DistanceField(DistanceField&&) = default;
+        DistanceField(const DistanceField&) = delete;
+
+        DistanceField& operator=(DistanceField&&) = default;
+        DistanceField& operator=(const DistanceField&) = delete;
+
+    public:
+        /**
+         *  \brief Get signed distance from center of a tile to the nearest
+         * boundary between passable and impassable tiles
+         *
+         *  If the mesh has no impassable tiles at all, every distance is the
+         * length of the diagonal of the mesh (negative of it if all tiles
+         * are impassable).
+         */
+        [[nodiscard]] float getDistance(const sf::Vector2u& tile) const noexcept
+        {
+            return distances[tile.y * dataSize.x + tile.x];
+        }
+
+        /**
+         *  \brief Get signed distance at a point of the world, interpolated
+         * from the four nearest tile centers
+         *
+         *  Points outside of the mesh get the value of the nearest point on
+         * its edge.
+         */
+        [[nodiscard]] float sample(const sf::Vector2f& point) const noexcept;
+
+        /**
+         *  \brief Get gradient of the field at a point of the world
+         *
+         *  Computed by central differences of sample over one tile.
+         * Gradient points away from the nearest wall and its length is close
+         * to one, except at points equally distant to multiple walls and
+         * near edges of the mesh.
+         */
+        [[nodiscard]] sf::Vector2f
+        getGradient(const sf::Vector2f& point) const noexcept;
+
+        /**
+         *  \brief Test whether a circle overlaps any wall of the mesh
+         *
+         *  Only a single sample is taken, so the result is approximate near
+         * corners of walls, where interpolation rounds the distances off.
+         */
+        [[nodiscard]] bool collides(const dgm::Circle& circle) const noexcept
+        {
+            return sample(circle.getPosition()) < circle.getRadius();
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getVoxelSize() const noexcept
+        {
+            return voxelSize;
+        }
+
+        /**
+         *  \brief Get position of top-left corner
+         */
+        [[nodiscard]] constexpr const sf::Vector2f&
+        getPosition() const noexcept
+        {
+            return position;
+        }
+
+        /**
+         *  \brief Version of the mesh the distances were computed from
+         */
+        [[nodiscard]] constexpr const MeshVersion&
+        getMeshVersion() const noexcept
+        {
+            return meshVersion;
+        }
+
+    private:
+        /**
+         *  \brief Four tile centers surrounding a point and its position
+         * between them
+         */
+        struct Cell
+        {
+            sf::Vector2u topLeft;
+            sf::Vector2u bottomRight;
+            sf::Vector2f weight;
+        };
+
+        [[nodiscard]] Cell getCell(const sf::Vector2f& point) const noexcept;
+
+    private:
+        sf::Vector2u dataSize;
+        sf::Vector2u voxelSize;
+        sf::Vector2f position;
+        MeshVersion meshVersion;
+        std::vector<float> distances = {};
+    };
+} // namespace dgm
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <DGM/classes/NavMesh.hpp>
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Distance and direction to the nearest goal for every tile of
+     * a mesh
+     *
+     *  Flow field is computed by a single Dijkstra pass from the goals over
+     * the whole mesh. Afterwards, any number of agents heading to the same
+     * goal can steer by looking up the direction of the tile they stand on,
+     * which is O(1) per agent.
+     *
+     *  Distances are expressed in the same units as the tile searches use
+     * internally: straight step costs STRAIGHT_COST and diagonal step costs
+     * DIAGONAL_COST.
+     *
+     *  Tile is passable if its value is <= 0, same as with
+     * dgm::TileNavMesh.
+     *
+     *  Goals can be added and removed without computing the whole field
+     * again. Editing the mesh is not incremental, call compute afterwards.
+     */
+    class [[nodiscard]] FlowField final
+    {
+    public:
+        using Connectivity = TileNavMesh::Connectivity;
+
+        static constexpr unsigned STRAIGHT_COST = 100;
+        static constexpr unsigned DIAGONAL_COST = 141;
+        static constexpr unsigned UNREACHABLE = ~0u;
+
+    public:
+        FlowField() = default;
+        FlowField(FlowField&&) = default;
+        FlowField(const FlowField&) = delete;
+
+        FlowField& operator=(FlowField&&) = default;
+        FlowField& operator=(const FlowField&) = delete;
+
+    public:
+        /**
+         *  \brief Compute flow field leading towards the nearest of goals
+         *
+         *  Goals that are impassable or outside of the mesh are ignored.
+         *
+         *  \param threadCount Number of threads expanding the wavefront.
+         * Result doesn't depend on it.
+         */
+        void compute(
+            const dgm::Mesh& mesh,
+            std::span<const sf::Vector2u> goals,
+            Connectivity connectivity = Connectivity::FourWay,
+            unsigned threadCount = 1);
+
+        void compute(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& goal,
+            Connectivity connectivity = Connectivity::FourWay,
+            unsigned threadCount = 1)
+        {
+            compute(mesh, std::span(&goal, 1), connectivity, threadCount);
+        }
+
+        /**
+         *  \brief Add more goals to already computed flow field
+         *
+         *  Only the tiles that get closer to one of the new goals are
+         * revisited, so this is much cheaper than computing the field from
+         * scratch when the new goals only affect part of the mesh.
+         *
+         *  \warn The mesh must be the same as in the last call to compute.
+         */
+        void addGoals(
+            const dgm::Mesh& mesh,
+            std::span<const sf::Vector2u> goals,
+            unsigned threadCount = 1);
+
+        /**
+         *  \brief Remove goals from already computed flow field
+         *
+         *  Only the tiles whose direction led to one of the removed goals
+         * are revisited. Their distances are recomputed from the tiles
+         * around them that still lead to one of the remaining goals.
+         * Tiles that are not goals are ignored.
+         *
+         *  \warn The mesh must be the same as in the last call to compute.
+         */
+        void removeGoals(
+            const dgm::Mesh& mesh,
+            std::span<const sf::Vector2u> goals,
+            unsigned threadCount = 1);
+
+        /**
+         *  \brief Get distance from tile to the nearest goal or UNREACHABLE
+         */
+        [[nodiscard]] unsigned
+        getDistance(const sf::Vector2u& tile) const noexcept
+        {
+            return distances[toIndex(tile)];
+        }
+
+        [[nodiscard]] bool isReachable(const sf::Vector2u& tile) const noexcept
+        {
+            return getDistance(tile) != UNREACHABLE;
+        }
+
+        /**
+         *  \brief Get step to take from a tile to get closer to the goal
+         *
+         *  Both components are from {-1, 0, 1}. Zero vector is returned for
+         * the goals themselves and for unreachable tiles.
+         */
+        [[nodiscard]] sf::Vector2i
+        getDirection(const sf::Vector2u& tile) const noexcept
+        {
+            return DIRECTIONS[directions[toIndex(tile)]];
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+    private:
+        using IndexType = std::uint32_t;
+
+        /**
+         *  Straight directions go first, so they are preferred when
+         * a straight and a diagonal step are equally good. Last one is the
+         * zero vector, used for goals and unreachable tiles.
+         */
+        static constexpr std::array<sf::Vector2i, 9> DIRECTIONS = {
+            sf::Vector2i(0, -1), sf::Vector2i(0, 1),   sf::Vector2i(-1, 0),
+            sf::Vector2i(1, 0),  sf::Vector2i(-1, -1), sf::Vector2i(1, -1),
+            sf::Vector2i(-1, 1), sf::Vector2i(1, 1),   sf::Vector2i(0, 0),
+        };
+        static constexpr std::uint8_t NO_DIRECTION = 8;
+
+    private:
+        [[nodiscard]] constexpr IndexType
+        toIndex(const sf::Vector2u& tile) const noexcept
+        {
+            return tile.y * dataSize.x + tile.x;
+        }
+
+        /**
+         *  Expands the wavefront from the seeded tiles until no distance
+         * can be improved and updates directions of all affected tiles.
+         * Seeds start from their current distances.
+         */
+        void propagate(
+            const dgm::Mesh& mesh,
+            std::vector<IndexType> seeds,
+            unsigned threadCount);
+
+        void updateDirections(
+            const dgm::Mesh& mesh,
+            std::span<const IndexType> changedTiles,
+            unsigned threadCount);
+
+    private:
+        sf::Vector2u dataSize = {};
+        Connectivity connectivity = Connectivity::FourWay;
+        std::vector<unsigned> distances = {};
+        std::vector<std::uint8_t> directions = {};
+    };
+} // namespace dgm
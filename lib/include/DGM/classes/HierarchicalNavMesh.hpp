@@ -0,0 +1,193 @@
+#pragma once
+
+#include <DGM/classes/NavMesh.hpp>
+#include <DGM/classes/Objects.hpp>
+#include <DGM/classes/Path.hpp>
+#include <DGM/classes/PathfindingContext.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Hierarchical navmesh (HPA*) for computing tile paths on large
+     * meshes
+     *
+     *  Mesh is split into square clusters. Passable tiles on the borders of
+     * neighboring clusters form entrances and each entrance contributes one
+     * or two pairs of abstract nodes. Distances between all nodes of a
+     * single cluster are precomputed during construction.
+     *
+     *  Query first searches the small abstract graph, which yields a
+     * sequence of waypoints where each two subsequent waypoints lie either
+     * in the same cluster or right next to each other. Each segment can then
+     * be refined into a tile path by a search limited to at most two
+     * clusters. Refinement can be done lazily, segment by segment, when the
+     * agent actually gets to it.
+     *
+     *  Paths use four-way movement, same as the default of
+     * dgm::TileNavMesh. They are near-optimal, usually within a few percent
+     * of the shortest path.
+     *
+     *  This class makes a copy of source mesh because it needs to do some
+     * pre-processing before it can do pathfinding. As long as your mesh data
+     * don't change, you can reuse object of this class.
+     */
+    class [[nodiscard]] HierarchicalNavMesh
+    {
+    public:
+        static constexpr unsigned DEFAULT_CLUSTER_SIZE = 16;
+
+    public:
+        HierarchicalNavMesh() = delete;
+
+        /**
+         *  \param clusterSize Width and height of a cluster in tiles, must
+         * be at least 2
+         */
+        explicit HierarchicalNavMesh(
+            dgm::Mesh mesh, unsigned clusterSize = DEFAULT_CLUSTER_SIZE);
+
+        HierarchicalNavMesh(HierarchicalNavMesh&&) = default;
+        HierarchicalNavMesh(const HierarchicalNavMesh&) = delete;
+
+    public:
+        /**
+         *  \brief Get sequence of waypoints leading from 'from' to 'to'
+         *
+         *  The resulting path will not include 'from' coord, but it includes
+         * 'to' coord. Use refinePathSegment on each two subsequent waypoints
+         * to get the tiles in between.
+         *
+         *  If no path exists, empty optional will be returned
+         *  If from == to, then empty path is returned
+         *
+         *  Querying doesn't modify the navmesh, so this function can be
+         * called from multiple threads at once, each with its own context.
+         */
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>>
+        computeAbstractPath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            PathfindingContext& context) const;
+
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>>
+        computeAbstractPath(
+            const sf::Vector2u& from, const sf::Vector2u& to) const;
+
+        /**
+         *  \brief Get tile path between two subsequent waypoints of an
+         * abstract path
+         *
+         *  Search is limited to the smallest block of clusters containing
+         * both points, so it is cheap for waypoints produced by
+         * computeAbstractPath. Resulting path has the same format as the one
+         * from dgm::TileNavMesh::computePath.
+         */
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>> refinePathSegment(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            PathfindingContext& context) const;
+
+        /**
+         *  \brief Get complete tile path from 'from' to 'to'
+         *
+         *  This is computeAbstractPath followed by refinement of all of its
+         * segments. Resulting path has the same format as the one from
+         * dgm::TileNavMesh::computePath.
+         */
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>> computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            PathfindingContext& context) const;
+
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>>
+        computePath(const sf::Vector2u& from, const sf::Vector2u& to) const;
+
+        [[nodiscard]] constexpr unsigned getClusterSize() const noexcept
+        {
+            return clusterSize;
+        }
+
+        /**
+         *  \brief Get number of nodes of the abstract graph
+         */
+        [[nodiscard]] std::size_t getAbstractNodeCount() const noexcept
+        {
+            return nodeConnections.size();
+        }
+
+    protected:
+        struct [[nodiscard]] Connection final
+        {
+            sf::Vector2u destination; ///< Destination node of the connection
+            unsigned distance;        ///< Distance to destination
+        };
+
+        /**
+         *  Half-open rectangle of tiles [topLeft, bottomRight)
+         */
+        struct [[nodiscard]] TileBounds final
+        {
+            sf::Vector2u topLeft;
+            sf::Vector2u bottomRight;
+
+            [[nodiscard]] constexpr bool
+            contains(const sf::Vector2u& point) const noexcept
+            {
+                return topLeft.x <= point.x && point.x < bottomRight.x
+                       && topLeft.y <= point.y && point.y < bottomRight.y;
+            }
+        };
+
+    protected:
+        void discoverEntrances();
+
+        void connectClusterNodes();
+
+        void registerNode(const sf::Vector2u& point);
+
+        void connectEntrance(const sf::Vector2u& a, const sf::Vector2u& b);
+
+        /**
+         *  Get distances from origin to all targets reachable without leaving
+         * the cluster of origin. Targets must lie in that cluster.
+         */
+        [[nodiscard]] std::vector<Connection> connectWithinCluster(
+            const sf::Vector2u& origin,
+            const std::vector<sf::Vector2u>& targets) const;
+
+        [[nodiscard]] std::size_t
+        getClusterIndex(const sf::Vector2u& point) const noexcept
+        {
+            return (point.y / clusterSize) * clusterCount.x
+                   + point.x / clusterSize;
+        }
+
+        [[nodiscard]] TileBounds
+        getClusterBounds(const sf::Vector2u& point) const noexcept;
+
+        [[nodiscard]] bool isWalkable(const sf::Vector2u& point) const
+        {
+            return mesh[point] <= 0;
+        }
+
+    protected:
+        dgm::Mesh mesh;
+        unsigned clusterSize;
+        sf::Vector2u clusterCount;
+
+        /**
+         *  Abstract graph, indexed by coordinates of the node
+         */
+        std::unordered_map<sf::Vector2u, std::vector<Connection>>
+            nodeConnections = {};
+
+        /**
+         *  Abstract nodes of each cluster, indexed by getClusterIndex
+         */
+        std::vector<std::vector<sf::Vector2u>> clusterNodes = {};
+    };
+} // namespace dgm
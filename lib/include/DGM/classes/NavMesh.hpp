@@ -1,7 +1,23 @@
+#pragma once
+
+#include <DGM/classes/ClearanceMap.hpp>
+#include <DGM/classes/ConnectedComponents.hpp>
+#include <DGM/classes/Error.hpp>
 #include <DGM/classes/Objects.hpp>
 #include <DGM/classes/Path.hpp>
+#include <DGM/classes/PathCache.hpp>
+#include <DGM/classes/PathfindingContext.hpp>
 #include <DGM/classes/Utility.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <thread>
 #include <unordered_map>
 
 namespace std
@@ -32,8 +48,9 @@ namespace dgm
      *  \brief Class for computing path from collision mesh data
      *
      *  This version of NavMesh computes sequence of tile indices
-     *  to get from tile A to tile B. Tiles are direct horizontal
-     *  or vertical neigbors, diagonal neighbors are ignored.
+     *  to get from tile A to tile B. By default, tiles are direct horizontal
+     *  or vertical neigbors, diagonal neighbors are ignored. Diagonal
+     *  movement can be enabled via SearchOptions.
      *
      *  Path is determined with regard to impassable tiles in dgm::Mesh
      * provided. If tile in mesh has value <= 0 then it is passible. Any value
@@ -41,6 +58,236 @@ namespace dgm
      */
     class TileNavMesh
     {
+    public:
+        /**
+         *  \brief Which neighbors of a tile can be reached in a single step
+         *
+         *  Diagonal step is only allowed if both tiles adjacent to it are
+         * passable, so paths never cut corners of impassable tiles.
+         */
+        enum class [[nodiscard]] Connectivity
+        {
+            FourWay,
+            EightWay
+        };
+
+        /// Cost of a straight step, as reported by computeDistance
+        static constexpr unsigned STRAIGHT_COST = 100;
+
+        /// Cost of a diagonal step, as reported by computeDistance
+        static constexpr unsigned DIAGONAL_COST = 141;
+
+        enum class [[nodiscard]] SearchAlgorithm
+        {
+            /// Plain A* expanding every tile
+            Astar,
+            /// A* only expanding jump points, producing paths of the same
+            /// length while expanding far fewer nodes on open maps
+            JumpPointSearch
+        };
+
+        /**
+         *  \brief Precomputed jump distances for JPS+
+         *
+         *  For each tile and each of the eight directions, table stores
+         * distance to the next jump point in that direction (positive value)
+         * or the number of steps that can be made before hitting an
+         * impassable tile (zero or negative value).
+         *
+         *  Table only depends on the mesh, so it can be built once per
+         * level load and then passed to any number of searches with
+         * SearchAlgorithm::JumpPointSearch. Table has to be rebuilt when the
+         * mesh changes.
+         */
+        class [[nodiscard]] JumpPointTable final
+        {
+        public:
+            JumpPointTable(const dgm::Mesh& mesh, Connectivity connectivity);
+
+            JumpPointTable(JumpPointTable&&) = default;
+            JumpPointTable(const JumpPointTable&) = delete;
+
+        public:
+            /**
+             *  \brief Get jump distance from a tile in given direction
+             *
+             *  \param direction Vector with both components from {-1, 0, 1},
+             * but not zero
+             */
+            [[nodiscard]] int getJumpDistance(
+                const sf::Vector2u& tile,
+                const sf::Vector2i& direction) const noexcept
+            {
+                return distances[tile.y * dataSize.x + tile.x]
+                                [toDirectionIndex(direction)];
+            }
+
+            [[nodiscard]] constexpr const sf::Vector2u&
+            getDataSize() const noexcept
+            {
+                return dataSize;
+            }
+
+            [[nodiscard]] constexpr Connectivity
+            getConnectivity() const noexcept
+            {
+                return connectivity;
+            }
+
+        private:
+            [[nodiscard]] static constexpr std::size_t
+            toDirectionIndex(const sf::Vector2i& direction) noexcept
+            {
+                // Maps [-1, 1]x[-1, 1] onto [0, 8] and skips the zero vector
+                const int index = (direction.y + 1) * 3 + (direction.x + 1);
+                return static_cast<std::size_t>(index < 4 ? index : index - 1);
+            }
+
+            int& at(const sf::Vector2u& tile, const sf::Vector2i& direction)
+            {
+                return distances[tile.y * dataSize.x + tile.x]
+                                [toDirectionIndex(direction)];
+            }
+
+        private:
+            sf::Vector2u dataSize;
+            Connectivity connectivity;
+            std::vector<std::array<int, 8>> distances;
+        };
+
+        struct [[nodiscard]] SearchOptions final
+        {
+            SearchAlgorithm algorithm = SearchAlgorithm::Astar;
+            Connectivity connectivity = Connectivity::FourWay;
+
+            /**
+             *  Optional JPS+ table, only used with
+             * SearchAlgorithm::JumpPointSearch. It must be built from the
+             * searched mesh with the same connectivity.
+             */
+            const JumpPointTable* jumpPointTable = nullptr;
+
+            /**
+             *  Optional connected components of the searched mesh. If set,
+             * queries between disconnected tiles fail immediately instead
+             * of exhausting the whole reachable area. Components that are
+             * not up to date with the mesh are ignored and the search runs
+             * in full.
+             */
+            const ConnectedComponents* components = nullptr;
+
+            /**
+             *  Agent spans agentSize by agentSize tiles and paths lead its
+             * top left tile. Agents larger than one tile require the
+             * clearance map, JPS+ table is not used for them.
+             */
+            unsigned agentSize = 1;
+
+            /**
+             *  Clearance map of the searched mesh, only used for agents
+             * larger than one tile. It must be up to date with the mesh,
+             * searches for large agents throw dgm::Exception if it is
+             * missing or out of date.
+             */
+            const ClearanceMap* clearance = nullptr;
+        };
+
+        /**
+         *  \brief Tile path search that can be spread over multiple frames
+         *
+         *  Each call to step expands at most given number of nodes, so even
+         * a search over a huge mesh never takes more than a bounded amount
+         * of time per frame. Open and closed nodes are kept between the
+         * calls. Resulting path is the same as the one from computePath
+         * with the same options.
+         *
+         *  Search owns a PathfindingContext sized to the mesh and it keeps
+         * a reference to the mesh, so the mesh must outlive the search and
+         * it must not change until the search is finished.
+         *
+         *  See dgm::PathSearchScheduler for distributing a per-frame budget
+         * among many searches.
+         */
+        class [[nodiscard]] PathSearch final
+        {
+        public:
+            enum class [[nodiscard]] Status
+            {
+                InProgress,
+                Found,
+                Unreachable
+            };
+
+        public:
+            PathSearch(
+                const sf::Vector2u& from,
+                const sf::Vector2u& to,
+                const dgm::Mesh& mesh,
+                const SearchOptions& options);
+
+            PathSearch(
+                const sf::Vector2u& from,
+                const sf::Vector2u& to,
+                const dgm::Mesh& mesh)
+                : PathSearch(from, to, mesh, SearchOptions {})
+            {
+            }
+
+            PathSearch(PathSearch&&) = default;
+            PathSearch(const PathSearch&) = delete;
+
+            PathSearch& operator=(PathSearch&&) = default;
+            PathSearch& operator=(const PathSearch&) = delete;
+
+        public:
+            /**
+             *  \brief Continue the search, expanding at most maxExpansions
+             * nodes
+             *
+             *  Does nothing if the search is already finished.
+             *
+             *  \return Number of nodes actually expanded
+             */
+            std::size_t step(std::size_t maxExpansions);
+
+            [[nodiscard]] constexpr Status getStatus() const noexcept
+            {
+                return status;
+            }
+
+            [[nodiscard]] constexpr bool isFinished() const noexcept
+            {
+                return status != Status::InProgress;
+            }
+
+            /**
+             *  \brief Get the resulting path
+             *
+             *  Returns empty optional unless the status is Status::Found.
+             */
+            [[nodiscard]] std::optional<dgm::Path<TileNavpoint>>
+            getPath() const;
+
+            /**
+             *  \brief Get number of nodes expanded by all calls to step
+             */
+            [[nodiscard]] constexpr std::size_t
+            getExpandedNodeCount() const noexcept
+            {
+                return expandedNodeCount;
+            }
+
+        private:
+            sf::Vector2u from;
+            sf::Vector2u to;
+            const dgm::Mesh* mesh;
+            SearchOptions options;
+            MeshVersion meshVersion;
+            PathfindingContext context = {};
+            Status status = Status::InProgress;
+            std::size_t expandedNodeCount = 0;
+        };
+
     public:
         TileNavMesh() = delete;
         TileNavMesh(const TileNavMesh&) = delete;
@@ -50,7 +297,8 @@ namespace dgm
          *  \brief Get path represented by tile indices to input mesh
          *
          *  The resulting path will not include 'from' coord, but it includes
-         * 'to' coord.
+         * 'to' coord. Every point of the path is a neighbor of the previous
+         * one, regardless of the algorithm used.
          *
          *  If no path exists, empty optional will be returned
          *  If from == to, then empty path (which returns true for isTraversed
@@ -60,6 +308,163 @@ namespace dgm
         computePath(
             const sf::Vector2u& from,
             const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const SearchOptions& options);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh)
+        {
+            return computePath(from, to, mesh, SearchOptions {});
+        }
+
+        /**
+         *  \brief Get path represented by tile indices to input mesh
+         *
+         *  Same as the overload above, but all temporary search data are
+         * stored in the provided context, so repeated queries don't allocate
+         * any memory.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathfindingContext& context,
+            const SearchOptions& options);
+
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathfindingContext& context)
+        {
+            return computePath(from, to, mesh, context, SearchOptions {});
+        }
+
+        /**
+         *  \brief Get path represented by tile indices to input mesh
+         *
+         *  Same as the overloads above, but the result is looked up in the
+         * cache first. Cached results are dropped automatically once the
+         * version of the mesh changes.
+         *
+         *  \warn Edit the mesh with setTile or call markModified after
+         * writing through operator[] or getRawData, otherwise the cache
+         * keeps serving paths computed before the edit.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathCache<TileNavpoint>& cache,
+            const SearchOptions& options);
+
+        /**
+         *  \brief Cached search with default options
+         *
+         *  \warn Same as above, edits of the mesh must change its version.
+         */
+        [[nodiscard]] static std::optional<dgm::Path<TileNavpoint>>
+        computePath(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathCache<TileNavpoint>& cache)
+        {
+            return computePath(from, to, mesh, cache, SearchOptions {});
+        }
+
+        /**
+         *  \brief Get length of the shortest path between two tiles
+         * without building the path
+         *
+         *  Straight step costs STRAIGHT_COST and diagonal step costs
+         * DIAGONAL_COST, the same units as dgm::FlowField uses.
+         *
+         *  \return Empty optional if no path exists, zero if from == to
+         */
+        [[nodiscard]] static std::optional<unsigned> computeDistance(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            PathfindingContext& context,
+            const SearchOptions& options);
+
+        [[nodiscard]] static std::optional<unsigned> computeDistance(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh,
+            const SearchOptions& options);
+
+        [[nodiscard]] static std::optional<unsigned> computeDistance(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            const dgm::Mesh& mesh)
+        {
+            return computeDistance(from, to, mesh, SearchOptions {});
+        }
+
+        /**
+         *  \brief Get lengths of the shortest paths from a tile to each of
+         * the targets
+         *
+         *  All targets are found by a single Dijkstra search that stops as
+         * soon as the last reachable target is settled, which is much
+         * cheaper than a separate query per target. Units are the same as
+         * with computeDistance. Search algorithm from the options is
+         * ignored, jump point search can't look for many targets at once.
+         *
+         *  \return Distance for each target, empty optional for targets
+         * that cannot be reached
+         */
+        [[nodiscard]] static std::vector<std::optional<unsigned>>
+        computeDistances(
+            const sf::Vector2u& from,
+            std::span<const sf::Vector2u> targets,
+            const dgm::Mesh& mesh,
+            PathfindingContext& context,
+            const SearchOptions& options);
+
+        [[nodiscard]] static std::vector<std::optional<unsigned>>
+        computeDistances(
+            const sf::Vector2u& from,
+            std::span<const sf::Vector2u> targets,
+            const dgm::Mesh& mesh,
+            const SearchOptions& options);
+
+        [[nodiscard]] static std::vector<std::optional<unsigned>>
+        computeDistances(
+            const sf::Vector2u& from,
+            std::span<const sf::Vector2u> targets,
+            const dgm::Mesh& mesh)
+        {
+            return computeDistances(from, targets, mesh, SearchOptions {});
+        }
+
+        /**
+         *  \brief Drop waypoints that can be skipped by walking straight
+         *
+         *  Waypoint is dropped whenever the tile after it is directly
+         * visible from the last kept waypoint (or from 'from'), as
+         * determined by dgm::Raycaster::hasDirectVisibility between the
+         * centers of the tiles. Only the points that were not traversed yet
+         * are considered.
+         *
+         *  Resulting path is a subsequence of the input path ending with the
+         * same point, but subsequent points are no longer neighbors. Looping
+         * paths are returned unchanged.
+         *
+         *  \param from Tile where the path starts, usually the 'from'
+         * argument of computePath
+         */
+        [[nodiscard]] static dgm::Path<TileNavpoint> smoothPath(
+            const sf::Vector2u& from,
+            const dgm::Path<TileNavpoint>& path,
             const dgm::Mesh& mesh);
     };
 
@@ -105,13 +510,62 @@ namespace dgm
      */
     class [[nodiscard]] WorldNavMesh
     {
+    public:
+        /**
+         *  \brief Single query for computePaths
+         */
+        struct [[nodiscard]] PathRequest final
+        {
+            sf::Vector2f from; ///< Start of the path in world coordinates
+            sf::Vector2f to;   ///< End of the path in world coordinates
+        };
+
+        static constexpr unsigned DEFAULT_LANDMARK_COUNT = 8;
+
     public:
         WorldNavMesh() = delete;
-        explicit WorldNavMesh(dgm::Mesh mesh);
+
+        /**
+         *  \brief Build jump point network of a mesh
+         *
+         *  Connections of the jump points are discovered by up to
+         * threadCount threads, calling thread takes part in the work too.
+         * The resulting network does not depend on the number of threads.
+         */
+        explicit WorldNavMesh(
+            dgm::Mesh mesh,
+            unsigned threadCount = std::thread::hardware_concurrency());
+
         WorldNavMesh(WorldNavMesh&& other) = default;
         WorldNavMesh(const WorldNavMesh& other) = delete;
 
+        /**
+         *  \brief Restore navmesh from a file created by saveToFile
+         *
+         *  Loading skips the jump point discovery, which makes it much
+         * faster than constructing the navmesh. The file is only accepted
+         * if it was saved for a mesh with the same dimensions, voxel size
+         * and layout of walls.
+         *
+         *  \return Error if the file cannot be read, is corrupted or does
+         * not match the mesh
+         */
+        [[nodiscard]] static std::expected<WorldNavMesh, dgm::Error>
+        loadFromFile(dgm::Mesh mesh, const std::filesystem::path& path);
+
     public:
+        /**
+         *  \brief Store precomputed jump point network to a binary file
+         *
+         *  The file uses native byte order and is meant to be shipped next
+         * to the level it was computed for. Use loadFromFile to restore it.
+         *
+         *  \return Error if there are pending changes or the file cannot be
+         * written
+         */
+        [[nodiscard]] dgm::ExpectedSuccess
+        saveToFile(const std::filesystem::path& path) const;
+
         /**
          *  \brief Get path represented by world coordinates
          *
@@ -120,60 +574,387 @@ namespace dgm
          *
          *  If no path exists, empty path is returned (isTraversed is true)
          *
-         *  \warn This function is not thread-safe.
+         *  Querying doesn't modify the navmesh, so this function can be
+         * called from multiple threads at once.
          */
         [[nodiscard]] dgm::Path<WorldNavpoint>
-        computePath(const sf::Vector2f& from, const sf::Vector2f& to);
+        computePath(const sf::Vector2f& from, const sf::Vector2f& to) const;
+
+        /**
+         *  \brief Get path represented by world coordinates
+         *
+         *  Same as the overload above, but all temporary search data are
+         * stored in the provided context, so repeated queries don't allocate
+         * any memory.
+         *
+         *  \warn Each thread must use its own context.
+         */
+        [[nodiscard]] dgm::Path<WorldNavpoint> computePath(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            PathfindingContext& context) const;
+
+        /**
+         *  \brief Get path represented by world coordinates
+         *
+         *  Same as the overloads above, but the result is looked up in the
+         * cache first. Points within the same tiles share the result. Cached
+         * results are dropped automatically by applyChanges.
+         *
+         *  Navmesh works with its own copy of the mesh, so the cache only
+         * notices edits made through setTile. Writes into the mesh the
+         * navmesh was constructed from never reach it.
+         *
+         *  \warn Each thread must use its own cache.
+         */
+        [[nodiscard]] dgm::Path<WorldNavpoint> computePath(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            PathCache<WorldNavpoint>& cache) const;
+
+        /**
+         *  \brief Compute paths for a batch of requests in parallel
+         *
+         *  Requests are distributed among up to threadCount threads, each of
+         * them reusing its own PathfindingContext. Calling thread takes part
+         * in the computation as well.
+         *
+         *  Threads and their contexts are not kept between calls, every call
+         * starts threadCount - 1 new threads and allocates a context per
+         * thread. Submit all requests of a frame in a single call rather
+         * than calling this once per unit, and pass threadCount of 1 for
+         * batches too small to pay off the start of the threads.
+         *
+         *  \return Paths in the same order as the requests
+         */
+        [[nodiscard]] std::vector<dgm::Path<WorldNavpoint>> computePaths(
+            std::span<const PathRequest> requests,
+            unsigned threadCount = std::thread::hardware_concurrency()) const;
+
+        /**
+         *  \brief Get length of the path computePath would return, without
+         * building it
+         *
+         *  Length is measured in world units between the centers of the
+         * tiles the path goes through.
+         *
+         *  \return Empty optional if no path exists, zero if both points lie
+         * within the same tile
+         */
+        [[nodiscard]] std::optional<float>
+        computeDistance(const sf::Vector2f& from, const sf::Vector2f& to) const;
+
+        /**
+         *  \brief Same as the overload above, but all temporary search data
+         * are stored in the provided context
+         *
+         *  \warn Each thread must use its own context.
+         */
+        [[nodiscard]] std::optional<float> computeDistance(
+            const sf::Vector2f& from,
+            const sf::Vector2f& to,
+            PathfindingContext& context) const;
+
+        /**
+         *  \brief Get lengths of the shortest paths from a point to each of
+         * the targets
+         *
+         *  All targets are found by a single Dijkstra search over the jump
+         * point network that stops as soon as the last reachable target is
+         * settled. Units are the same as with computeDistance.
+         *
+         *  \return Distance for each target, empty optional for targets
+         * that cannot be reached
+         */
+        [[nodiscard]] std::vector<std::optional<float>> computeDistances(
+            const sf::Vector2f& from,
+            std::span<const sf::Vector2f> targets) const;
+
+        /**
+         *  \brief Same as the overload above, but all temporary search data
+         * are stored in the provided context
+         *
+         *  \warn Each thread must use its own context.
+         */
+        [[nodiscard]] std::vector<std::optional<float>> computeDistances(
+            const sf::Vector2f& from,
+            std::span<const sf::Vector2f> targets,
+            PathfindingContext& context) const;
+
+        /**
+         *  \brief Change value of a single tile of the underlying mesh
+         *
+         *  Jump point network is not updated until applyChanges is called,
+         * so multiple tiles can be changed at once (an explosion, opening a
+         * door, ...) and the network is updated only once.
+         *
+         *  \warn Do not compute paths while there are pending changes.
+         */
+        void setTile(const sf::Vector2u& tile, int value);
+
+        /**
+         *  \brief Update jump point network after calls to setTile
+         *
+         *  Only the jump points around the changed tiles are re-evaluated and
+         * only the jump points that scanned through the changed region have
+         * their connections recomputed. Resulting network is the same as if
+         * the navmesh was constructed from the modified mesh.
+         */
+        void applyChanges();
+
+        [[nodiscard]] constexpr bool hasPendingChanges() const noexcept
+        {
+            return dirtyBounds.has_value();
+        }
+
+        /**
+         *  \brief Precompute data for the landmark (ALT) heuristic
+         *
+         *  Landmarks are jump points picked to be as far from each other as
+         * possible. Exact distances from every landmark to every jump point
+         * are stored, which costs landmarkCount * jump point count integers.
+         * Queries then use the triangle inequality to get a much tighter
+         * lower bound of the remaining distance than the straight line
+         * distance, which greatly reduces number of expanded nodes on
+         * maps made of rooms and doors. Resulting paths are still optimal.
+         *
+         *  On maps made of long narrow corridors, straight line distance
+         * already keeps the search narrow and landmarks might not pay off.
+         *
+         *  Landmarks are recomputed by applyChanges and they are not stored
+         * by saveToFile. Pass zero to drop them.
+         */
+        void computeLandmarks(unsigned landmarkCount = DEFAULT_LANDMARK_COUNT);
+
+        [[nodiscard]] unsigned getLandmarkCount() const noexcept
+        {
+            return static_cast<unsigned>(landmarks.size());
+        }
 
     protected:
+        /**
+         *  \brief Index of a jump point within the network
+         */
+        using NodeId = std::uint32_t;
+
+        static constexpr NodeId INVALID_NODE =
+            std::numeric_limits<NodeId>::max();
+
+        static constexpr unsigned UNREACHABLE =
+            std::numeric_limits<unsigned>::max();
+
         struct [[nodiscard]] Connection final
         {
             sf::Vector2u destination; ///< Destination node of the connection
             unsigned distance;        ///< Distance to destination
         };
 
+        /**
+         *  Inclusive rectangle of tiles
+         */
+        struct [[nodiscard]] TileBounds final
+        {
+            sf::Vector2u topLeft;
+            sf::Vector2u bottomRight;
+
+            constexpr void extend(const sf::Vector2u& point) noexcept
+            {
+                topLeft.x = std::min(topLeft.x, point.x);
+                topLeft.y = std::min(topLeft.y, point.y);
+                bottomRight.x = std::max(bottomRight.x, point.x);
+                bottomRight.y = std::max(bottomRight.y, point.y);
+            }
+
+            [[nodiscard]] constexpr bool
+            intersects(const TileBounds& other) const noexcept
+            {
+                return topLeft.x <= other.bottomRight.x
+                       && other.topLeft.x <= bottomRight.x
+                       && topLeft.y <= other.bottomRight.y
+                       && other.topLeft.y <= bottomRight.y;
+            }
+        };
+
+        /**
+         *  \brief Landmark used by a single query
+         */
+        struct [[nodiscard]] ActiveLandmark final
+        {
+            unsigned landmark;      ///< Index of the landmark
+            unsigned toDestination; ///< Distance to the query destination
+        };
+
+        /**
+         *  How many landmarks are used by a single query
+         */
+        static constexpr std::size_t ACTIVE_LANDMARK_COUNT = 4;
+
+    private:
+        /**
+         *  Tag for constructing navmesh without building the network
+         */
+        struct [[nodiscard]] EmptyNetwork final
+        {
+        };
+
+        WorldNavMesh(dgm::Mesh mesh, EmptyNetwork);
+
     protected:
         dgm::Mesh mesh;
 
         /**
-         *  \brief Map of connections between jump points
+         *  \brief Connected components of the mesh
          *
-         *  Map is indexed by jump point coordinates and each jump point lists
-         * set of jump points it is connected to, alonside with distance to each
-         * of them.
+         *  Queries between disconnected tiles are rejected before any
+         * search starts, unless there are tile changes the components
+         * don't know about yet.
+         */
+        ConnectedComponents components;
+
+        /**
+         *  \brief Node id of every tile of the mesh
+         *
+         *  Indexed the same way as the mesh, tiles that are not jump points
+         * have INVALID_NODE.
+         */
+        std::vector<NodeId> tileNodes = {};
+
+        /**
+         *  \brief Coordinates of jump points, indexed by node id
+         *
+         *  Nodes are sorted by their row and then by their column.
+         */
+        std::vector<sf::Vector2u> nodeCoords = {};
+
+        /**
+         *  \brief All tiles examined while discovering connections of each
+         * node
+         *
+         *  Connections of a jump point have to be recomputed only if a tile
+         * within these bounds changes.
+         */
+        std::vector<TileBounds> nodeScanBounds = {};
+
+        /**
+         *  \brief Connections between jump points in compressed sparse row
+         * layout
+         *
+         *  Connections of node i are stored in range [edgeOffsets[i],
+         * edgeOffsets[i + 1]) of edges, so expanding a node is a walk over
+         * a contiguous block of memory.
          *
          *  Jump points are only relevant for computation of WorldNavpoints
          */
-        std::unordered_map<sf::Vector2u, std::vector<Connection>>
-            jumpPointConnections = {};
+        std::vector<std::uint32_t> edgeOffsets = { 0u };
+        std::vector<Connection> edges = {};
+
+        /**
+         *  \brief Nodes picked as landmarks by computeLandmarks
+         */
+        std::vector<NodeId> landmarks = {};
+
+        /**
+         *  \brief Distance from each landmark to each node
+         *
+         *  Distances of node i are stored in range [i * landmark count,
+         * (i + 1) * landmark count), UNREACHABLE if the node cannot be
+         * reached from the landmark.
+         */
+        std::vector<unsigned> landmarkDistances = {};
+
+        /**
+         *  \brief Tiles changed by setTile since the last applyChanges
+         */
+        std::optional<TileBounds> dirtyBounds = std::nullopt;
 
     protected:
-        [[nodiscard]] bool isJumpPoint(const sf::Vector2u& p) const
+        [[nodiscard]] NodeId getNode(const sf::Vector2u& p) const noexcept
+        {
+            const auto size = mesh.getDataSize();
+            return p.x < size.x && p.y < size.y ? tileNodes[p.y * size.x + p.x]
+                                                : INVALID_NODE;
+        }
+
+        [[nodiscard]] bool isJumpPoint(const sf::Vector2u& p) const noexcept
         {
-            return jumpPointConnections.contains(p);
+            return getNode(p) != INVALID_NODE;
         }
 
-        void discoverConnectionsForJumpPoint(
-            const sf::Vector2u& point, bool symmetricConnection = false);
+        [[nodiscard]] std::span<const Connection>
+        getNodeConnections(NodeId node) const noexcept
+        {
+            return std::span(edges).subspan(
+                edgeOffsets[node], edgeOffsets[node + 1] - edgeOffsets[node]);
+        }
+
+        [[nodiscard]] bool
+        shouldRegisterAsJumpPoint(const sf::Vector2u& point) const;
+
+        /**
+         *  \brief Find all jump points directly reachable from a point
+         *
+         *  \param auxiliaryJumpPoint Point that should be treated as
+         * a jump point even though it is not part of the network
+         *  \param scanBounds If set, it receives bounds of all tiles that
+         * were examined during the discovery
+         */
+        [[nodiscard]] std::vector<Connection> discoverConnectionsForJumpPoint(
+            const sf::Vector2u& point,
+            const std::optional<sf::Vector2u>& auxiliaryJumpPoint =
+                std::nullopt,
+            TileBounds* scanBounds = nullptr) const;
 
-        void connectTwoJumpPoints(
-            const sf::Vector2u& a,
-            const sf::Vector2u& b,
-            bool symmetricConnection);
+        /**
+         *  \brief Get distance from every landmark to a point
+         *
+         *  \param connections Connections of the point, used unless it is
+         * a jump point
+         */
+        [[nodiscard]] std::vector<unsigned> getLandmarkDistances(
+            const sf::Vector2u& point,
+            std::span<const Connection> connections) const;
 
-        void connectToAndFromPointsToTheNetwork(
-            const sf::Vector2u& tileFrom, const sf::Vector2u& tileTo);
+        /**
+         *  \brief Pick landmarks giving the best lower bound of distance
+         * between source and destination
+         */
+        [[nodiscard]] std::vector<ActiveLandmark> getActiveLandmarks(
+            const std::vector<unsigned>& sourceDistances,
+            const std::vector<unsigned>& destinationDistances) const;
 
-        void eraseFromAndToPointsFromTheNetwork(
+        /**
+         *  \brief Discover connections of the next node and append them
+         * to the edge arrays
+         *
+         *  Nodes have to be appended in the order of their ids.
+         */
+        void appendNodeConnections(NodeId node);
+
+        /**
+         *  \brief Discover connections of all nodes in parallel and
+         * append them to the empty edge arrays
+         */
+        void appendAllNodeConnections(unsigned threadCount);
+
+        /**
+         *  \brief Run A* over the network between two distinct tiles
+         *
+         *  \return Length of the path if it exists, the path itself can be
+         * reconstructed from the context
+         */
+        [[nodiscard]] std::optional<unsigned> searchNetwork(
             const sf::Vector2u& tileFrom,
-            bool wasTileFromOriginallyJumpPoint,
             const sf::Vector2u& tileTo,
-            bool wasTileToOriginallyJumpPoint);
+            PathfindingContext& context) const;
+
+        [[nodiscard]] unsigned
+        getDistance(const sf::Vector2u& a, const sf::Vector2u& b) const;
 
-        [[nodiscard]] sf::Vector2u toTileCoord(const sf::Vector2f& coord);
+        [[nodiscard]] sf::Vector2u
+        toTileCoord(const sf::Vector2f& coord) const;
 
         [[nodiscard]] WorldNavpoint
-        toWorldNavpoint(const sf::Vector2u& coord);
+        toWorldNavpoint(const sf::Vector2u& coord) const;
     };
 
 } // namespace dgm
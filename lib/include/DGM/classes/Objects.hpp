@@ -9,7 +9,9 @@
 #include <DGM/classes/Compatibility.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <vector>
 
 namespace dgm
@@ -258,6 +260,23 @@ namespace dgm
         sf::Angle rotation = sf::Angle::Zero;
     };
 
+    /**
+     *  \brief Identification of the contents of a mesh
+     *
+     *  Two versions compare equal only if they were obtained from the same
+     * mesh and it was not marked as modified in between, so they can be
+     * used to tell whether results computed from the mesh are still up to
+     * date.
+     */
+    struct [[nodiscard]] MeshVersion final
+    {
+        std::uint64_t instanceId = 0;
+        std::uint64_t modificationCount = 0;
+
+        [[nodiscard]] constexpr bool
+        operator==(const MeshVersion&) const noexcept = default;
+    };
+
     /**
      *  \brief Logic class for representing level geometry or per-pixel
      * collision hitboxes
@@ -362,6 +381,13 @@ namespace dgm
         }
 #endif
 
+        /**
+         *  \brief Get writable data of the mesh
+         *
+         *  Call markModified after writing through the returned reference
+         * (or through non-const operator[]), otherwise results computed from
+         * the mesh cannot tell they are out of date.
+         */
         [[nodiscard]] constexpr inline std::vector<DataType>&
         getRawData() noexcept
         {
@@ -374,6 +400,45 @@ namespace dgm
             return data;
         }
 
+        /**
+         *  \brief Write a value into a tile and mark the mesh as modified
+         */
+        constexpr void setTile(std::size_t index, DataType value) noexcept
+        {
+            data[index] = value;
+            markModified();
+        }
+
+        /**
+         *  \brief Write a value into a tile and mark the mesh as modified
+         */
+        constexpr void
+        setTile(const sf::Vector2u& pos, DataType value) noexcept
+        {
+            setTile(pos.y * dataSize.x + pos.x, value);
+        }
+
+        /**
+         *  \brief Change version of the mesh after its data were written
+         * through operator[] or getRawData
+         */
+        constexpr void markModified() noexcept
+        {
+            ++version.modificationCount;
+        }
+
+        /**
+         *  \brief Get version of the mesh data
+         *
+         *  Version changes with setTile, markModified and setDataSize.
+         * Cloned mesh gets a version of its own.
+         */
+        [[nodiscard]] constexpr inline const MeshVersion&
+        getVersion() const noexcept
+        {
+            return version;
+        }
+
         /**
          *  \brief get position of top-left corner
          */
@@ -448,6 +513,7 @@ namespace dgm
          */
         void setDataSize(const sf::Vector2u& size)
         {
+            ++version.modificationCount;
             data.clear();
             data.resize(size.x * size.y, 0);
             dataSize = size;
@@ -461,6 +527,13 @@ namespace dgm
             position += forward;
         }
 
+    private:
+        [[nodiscard]] static std::uint64_t generateInstanceId() noexcept
+        {
+            static std::atomic<std::uint64_t> nextInstanceId = 1;
+            return nextInstanceId.fetch_add(1, std::memory_order_relaxed);
+        }
+
     protected:
         std::vector<DataType> data = {}; ///< Array for holding collision data
         sf::Vector2f position = { 0.f, 0.f }; ///< Position of top-left corner
@@ -470,6 +543,9 @@ namespace dgm
         sf::Vector2u voxelSize = {
             0u, 0u
         }; ///< How big rectangle does single cell of data represents
+        MeshVersion version = {
+            .instanceId = generateInstanceId()
+        }; ///< Changed by setTile, markModified and setDataSize
     };
 
     using Mesh = GenericMesh<int>;
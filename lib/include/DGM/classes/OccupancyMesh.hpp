@@ -0,0 +1,190 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Impassable tiles of a mesh packed into one bit per tile
+     *
+     *  Collision tests only ask whether a tile is impassable, so storing
+     * the whole int of dgm::Mesh for each tile wastes memory bandwidth.
+     * Each row of the occupancy mesh is stored as 64-bit words, so a whole
+     * span of up to 64 tiles is tested with a single mask.
+     *
+     *  Position and voxel size are copied from the mesh, so the occupancy
+     * mesh can be passed to dgm::Collision::basic instead of the mesh
+     * itself. Call update whenever the mesh changes.
+     */
+    class [[nodiscard]] OccupancyMesh final
+    {
+    public:
+        using WordType = std::uint64_t;
+
+        static constexpr unsigned BITS_PER_WORD = 64;
+
+    public:
+        explicit OccupancyMesh(const dgm::Mesh& mesh);
+
+        OccupancyMesh(OccupancyMesh&&) = default;
+        OccupancyMesh(const OccupancyMesh&) = delete;
+
+        OccupancyMesh& operator=(OccupancyMesh&&) = default;
+        OccupancyMesh& operator=(const OccupancyMesh&) = delete;
+
+    public:
+        /**
+         *  \brief Update occupancy after some tiles of the mesh changed
+         *
+         *  Position and voxel size are copied from the mesh again.
+         *
+         *  \param topLeft Top left corner of inclusive rectangle containing
+         * all changed tiles
+         *  \param bottomRight Bottom right corner of the rectangle
+         */
+        void update(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight);
+
+        /**
+         *  \brief Update occupancy after a single tile of the mesh changed
+         */
+        void update(const dgm::Mesh& mesh, const sf::Vector2u& tile)
+        {
+            update(mesh, tile, tile);
+        }
+
+        [[nodiscard]] bool isOccupied(const sf::Vector2u& tile) const noexcept
+        {
+            return (getWord(tile.x / BITS_PER_WORD, tile.y)
+                    >> (tile.x % BITS_PER_WORD))
+                   & 1u;
+        }
+
+        /**
+         *  \brief Count impassable tiles within inclusive rectangle
+         *
+         *  Rectangle must lie within the mesh.
+         */
+        [[nodiscard]] std::size_t countOccupiedTiles(
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight) const noexcept;
+
+        /**
+         *  \brief Find first impassable tile within inclusive rectangle, in
+         * row-major order
+         *
+         *  Rectangle must lie within the mesh.
+         */
+        [[nodiscard]] std::optional<sf::Vector2u> findOccupiedTile(
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight) const noexcept
+        {
+            return findOccupiedTile(
+                topLeft, bottomRight, [](const sf::Vector2u&) { return true; });
+        }
+
+        /**
+         *  \brief Find first impassable tile within inclusive rectangle, in
+         * row-major order, that satisfies a predicate
+         *
+         *  Predicate is only called for impassable tiles, so empty parts of
+         * the rectangle are skipped a whole word at a time.
+         */
+        template<class Predicate>
+        [[nodiscard]] std::optional<sf::Vector2u> findOccupiedTile(
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight,
+            Predicate&& predicate) const
+        {
+            const unsigned firstWord = topLeft.x / BITS_PER_WORD;
+            const unsigned lastWord = bottomRight.x / BITS_PER_WORD;
+            for (unsigned y = topLeft.y; y <= bottomRight.y; ++y)
+            {
+                for (unsigned w = firstWord; w <= lastWord; ++w)
+                {
+                    WordType bits = getWord(w, y)
+                                    & getSpanMask(w, topLeft.x, bottomRight.x);
+                    while (bits != 0)
+                    {
+                        const auto tile = sf::Vector2u(
+                            w * BITS_PER_WORD
+                                + static_cast<unsigned>(std::countr_zero(bits)),
+                            y);
+                        if (predicate(tile)) return tile;
+                        bits &= bits - 1;
+                    }
+                }
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getVoxelSize() const noexcept
+        {
+            return voxelSize;
+        }
+
+        /**
+         *  \brief Get position of top-left corner
+         */
+        [[nodiscard]] constexpr const sf::Vector2f&
+        getPosition() const noexcept
+        {
+            return position;
+        }
+
+        /**
+         *  \brief Version of the mesh the occupancy was computed from
+         */
+        [[nodiscard]] constexpr const MeshVersion&
+        getMeshVersion() const noexcept
+        {
+            return meshVersion;
+        }
+
+    private:
+        [[nodiscard]] WordType getWord(unsigned w, unsigned y) const noexcept
+        {
+            return words[y * wordsPerRow + w];
+        }
+
+        /**
+         *  \brief Get bits of a word that lie within inclusive range of
+         * columns
+         */
+        [[nodiscard]] static constexpr WordType
+        getSpanMask(unsigned w, unsigned fromX, unsigned toX) noexcept
+        {
+            const unsigned wordStart = w * BITS_PER_WORD;
+            const unsigned from = std::max(fromX, wordStart) - wordStart;
+            const unsigned to =
+                std::min(toX, wordStart + BITS_PER_WORD - 1) - wordStart;
+            return (~WordType {} << from)
+                   & (~WordType {} >> (BITS_PER_WORD - 1 - to));
+        }
+
+    private:
+        sf::Vector2u dataSize;
+        sf::Vector2u voxelSize;
+        sf::Vector2f position;
+        MeshVersion meshVersion;
+        unsigned wordsPerRow = 0;
+
+        /// Rows padded to whole words, padding bits are always zero
+        std::vector<WordType> words = {};
+    };
+} // namespace dgm
@@ -6,6 +6,8 @@
 #include <cassert>
 #include <cstdint>
 #include <iterator>
+#include <memory>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -44,6 +46,65 @@ namespace dgm
     static_assert(std::is_trivially_destructible_v<TileNavpoint>);
     static_assert(std::is_trivially_destructible_v<WorldNavpoint>);
 
+    /**
+     *  \brief Position of an agent within a path
+     *
+     *  Cursor only stores the index of the current point and whether it
+     * loops, so a group of agents following the same route can share
+     * a single list of points, each of them with its own cursor. Length of
+     * the path has to be provided by the caller.
+     */
+    class [[nodiscard]] PathCursor final
+    {
+    public:
+        constexpr PathCursor() noexcept = default;
+
+        constexpr explicit PathCursor(bool looping) noexcept
+            : looping(looping)
+        {
+        }
+
+    public:
+        /**
+         *  \brief Test whether there are no more points in the path
+         *
+         *  \note Looping cursor can never reach the end of a non-empty path
+         */
+        [[nodiscard]] constexpr bool
+        isTraversed(std::size_t pathLength) const noexcept
+        {
+            return pathLength <= index;
+        }
+
+        [[nodiscard]] constexpr bool isLooping() const noexcept
+        {
+            return looping;
+        }
+
+        /**
+         *  \brief Get index of the currently processed point
+         */
+        [[nodiscard]] constexpr std::size_t getIndex() const noexcept
+        {
+            return index;
+        }
+
+        /**
+         *  \brief Move to the next point
+         */
+        constexpr void advance(std::size_t pathLength) noexcept
+        {
+            index++;
+            if (isLooping() && isTraversed(pathLength)) index = 0;
+        }
+
+    private:
+        std::size_t index = 0; ///< Index of the currently processed point
+        bool looping = false;  ///< Whether the cursor loops
+    };
+
+    static_assert(sizeof(PathCursor) <= 2 * sizeof(std::size_t));
+
     /**
      *  \brief Class represeting a list of navigation paths to traverse
      *
@@ -53,6 +114,11 @@ namespace dgm
      * never traversed as advance will loop back to beginning if last point in
      * list is reached.
      *
+     *  Points of the path are immutable and reference-counted, so cloning
+     * a path is O(1) and all clones share the same points, each with its own
+     * PathCursor. Memory used by paths thus scales with the number of unique
+     * routes, not with the number of agents following them.
+     *
      *  This class is constructible either directly or from LevelD::Path.
      */
     template<class T>
@@ -60,9 +126,18 @@ namespace dgm
                  || std::is_same<WorldNavpoint, T>::value
     class [[nodiscard]] Path final
     {
+    public:
+        using PointsPtr = std::shared_ptr<const std::vector<T>>;
+
     public:
         Path(const std::vector<T>& points, bool looping)
-            : points(points), looping(looping)
+            : Path(std::vector<T>(points), looping)
+        {
+        }
+
+        Path(std::vector<T>&& points, bool looping)
+            : points(std::make_shared<const std::vector<T>>(std::move(points)))
+            , cursor(looping)
         {
         }
 
@@ -72,6 +147,21 @@ namespace dgm
 
         Path<T>& operator=(dgm::Path<T>&& other) = default;
 
+        /**
+         *  \brief Create a path sharing points with other paths
+         */
+        [[nodiscard]] static Path<T>
+        fromSharedPoints(PointsPtr points, bool looping)
+        {
+            assert(points);
+            return Path(std::move(points), PathCursor(looping));
+        }
+
+        /**
+         *  \brief Get a copy of the path, including its current point
+         *
+         *  Points are not copied, the clone shares them with this path.
+         */
         [[nodiscard]]
         Path<T> clone() const
         {
@@ -81,6 +171,11 @@ namespace dgm
     private:
         Path(const Path&) = default;
 
+        Path(PointsPtr points, PathCursor cursor)
+            : points(std::move(points)), cursor(cursor)
+        {
+        }
+
     public:
         /**
          *  \brief Test whether there are no more points in the list
@@ -89,12 +184,12 @@ namespace dgm
          */
         [[nodiscard]] constexpr bool isTraversed() const noexcept
         {
-            return points.size() <= currentPointIndex;
+            return cursor.isTraversed(getLength());
         }
 
         [[nodiscard]] constexpr bool isLooping() const noexcept
         {
-            return looping;
+            return cursor.isLooping();
         }
 
         /**
@@ -106,7 +201,7 @@ namespace dgm
         [[nodiscard]] constexpr const T& getCurrentPoint() const noexcept
         {
             assert(not isTraversed());
-            return points[currentPointIndex];
+            return (*points)[cursor.getIndex()];
         }
 
         /**
@@ -114,21 +209,41 @@ namespace dgm
          */
         constexpr void advance() noexcept
         {
-            currentPointIndex++;
-            if (isLooping() && isTraversed()) currentPointIndex = 0;
+            cursor.advance(getLength());
         }
 
         // template<typename = std::enable_if_t<std::is_same_v<T,
         // TileNavpoint>>>
         [[nodiscard]] constexpr std::size_t getLength() const noexcept
         {
-            return points.size();
+            return points ? points->size() : 0;
+        }
+
+        /**
+         *  \brief Get all points of the path, including the traversed ones
+         */
+        [[nodiscard]] std::span<const T> getPoints() const noexcept
+        {
+            return points ? std::span<const T>(*points) : std::span<const T>();
+        }
+
+        /**
+         *  \brief Get points of the path for sharing with other paths or
+         * with cursors
+         */
+        [[nodiscard]] constexpr const PointsPtr&
+        getSharedPoints() const noexcept
+        {
+            return points;
+        }
+
+        [[nodiscard]] constexpr const PathCursor& getCursor() const noexcept
+        {
+            return cursor;
         }
 
     protected:
-        std::vector<T> points = {}; ///< List of points to travese
-        bool looping = false;       ///< Whether the path loops
-        std::size_t currentPointIndex =
-            0; ///< Index to currently processed navpoint
+        PointsPtr points = {}; ///< Immutable list of points to traverse
+        PathCursor cursor = {}; ///< Currently processed point
     };
 } // namespace dgm
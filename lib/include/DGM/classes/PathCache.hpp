@@ -0,0 +1,204 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <DGM/classes/Path.hpp>
+#include <DGM/classes/PathfindingContext.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace dgm
+{
+    /**
+     *  \brief Least recently used cache of pathfinding results
+     *
+     *  Results are keyed by the start and destination tiles of the query,
+     * by a query variant distinguishing searches with different options and
+     * by the version of the mesh they were computed from. Once the mesh
+     * changes, all cached results are dropped on the next query, so edits
+     * of the mesh never yield stale paths.
+     *
+     *  Only edits that change the version of the mesh are noticed, so
+     * write tiles with dgm::Mesh::setTile or call dgm::Mesh::markModified
+     * after writing through operator[] or getRawData. A plain write like
+     * mesh[{ x, y }] = 1 alone leaves the old paths in the cache.
+     *
+     *  Unreachable destinations are cached as well, so repeatedly asking
+     * for an impossible path is cheap too.
+     *
+     *  Cache owns a PathfindingContext that is used for searches on misses.
+     * Pass it to computePath overloads of dgm::TileNavMesh and
+     * dgm::WorldNavMesh.
+     *
+     *  \warn Cache is not thread-safe, use one cache per thread.
+     */
+    template<class T>
+        requires std::is_same<TileNavpoint, T>::value
+                 || std::is_same<WorldNavpoint, T>::value
+    class [[nodiscard]] PathCache final
+    {
+    public:
+        using ResultType = std::optional<dgm::Path<T>>;
+
+        struct [[nodiscard]] Statistics final
+        {
+            std::size_t hitCount = 0;
+            std::size_t missCount = 0;
+
+            /// How many times the cache was dropped because of a mesh change
+            std::size_t invalidationCount = 0;
+        };
+
+        static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+    public:
+        /**
+         *  \param capacity Maximum number of cached results, at least one
+         */
+        explicit PathCache(std::size_t capacity = DEFAULT_CAPACITY)
+            : capacity(std::max(capacity, std::size_t { 1 }))
+        {
+        }
+
+        PathCache(PathCache&&) = default;
+        PathCache(const PathCache&) = delete;
+
+        PathCache& operator=(PathCache&&) = default;
+        PathCache& operator=(const PathCache&) = delete;
+
+    public:
+        /**
+         *  \brief Get cached result of a query or compute and store it
+         *
+         *  \param variant Distinguishes queries with the same endpoints
+         * that can have different results, like searches with different
+         * options
+         *  \param meshVersion Version of the mesh the query is computed from
+         *  \param compute Invoked with the context of the cache on a miss
+         */
+        template<std::invocable<PathfindingContext&> Compute>
+        [[nodiscard]] ResultType getOrCompute(
+            const sf::Vector2u& from,
+            const sf::Vector2u& to,
+            std::uint32_t variant,
+            const MeshVersion& meshVersion,
+            Compute&& compute)
+        {
+            if (meshVersion != version)
+            {
+                if (!entries.empty()) ++statistics.invalidationCount;
+                clear();
+                version = meshVersion;
+            }
+
+            const auto key = Key { from, to, variant };
+            if (auto itr = lookup.find(key); itr != lookup.end())
+            {
+                ++statistics.hitCount;
+                entries.splice(entries.begin(), entries, itr->second);
+                return cloneResult(itr->second->result);
+            }
+
+            ++statistics.missCount;
+            auto result = std::invoke(std::forward<Compute>(compute), context);
+
+            if (entries.size() == capacity)
+            {
+                lookup.erase(entries.back().key);
+                entries.pop_back();
+            }
+            entries.push_front(Entry { key, cloneResult(result) });
+            lookup.emplace(key, entries.begin());
+
+            return result;
+        }
+
+        /**
+         *  \brief Drop all cached results
+         *
+         *  Statistics are kept.
+         */
+        void clear() noexcept
+        {
+            lookup.clear();
+            entries.clear();
+        }
+
+        [[nodiscard]] constexpr const Statistics&
+        getStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+        void resetStatistics() noexcept
+        {
+            statistics = {};
+        }
+
+        /**
+         *  \brief Get number of currently cached results
+         */
+        [[nodiscard]] std::size_t getSize() const noexcept
+        {
+            return entries.size();
+        }
+
+        [[nodiscard]] constexpr std::size_t getCapacity() const noexcept
+        {
+            return capacity;
+        }
+
+    private:
+        struct [[nodiscard]] Key final
+        {
+            sf::Vector2u from;
+            sf::Vector2u to;
+            std::uint32_t variant;
+
+            [[nodiscard]] constexpr bool
+            operator==(const Key&) const noexcept = default;
+        };
+
+        struct [[nodiscard]] KeyHash final
+        {
+            [[nodiscard]] std::size_t operator()(const Key& key) const noexcept
+            {
+                // FNV-1a style mixing of all components
+                std::size_t hash = key.variant;
+                for (auto&& value :
+                     { key.from.x, key.from.y, key.to.x, key.to.y })
+                    hash = (hash ^ value) * 0x100000001b3ull;
+                return hash;
+            }
+        };
+
+        struct [[nodiscard]] Entry final
+        {
+            Key key;
+            ResultType result;
+        };
+
+    private:
+        [[nodiscard]] static ResultType
+        cloneResult(const ResultType& result)
+        {
+            return result ? ResultType(result->clone()) : std::nullopt;
+        }
+
+    private:
+        std::size_t capacity;
+        MeshVersion version = {};
+        Statistics statistics = {};
+        PathfindingContext context = {};
+
+        /// Most recently used entry is at the front
+        std::list<Entry> entries = {};
+        std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash>
+            lookup = {};
+    };
+} // namespace dgm
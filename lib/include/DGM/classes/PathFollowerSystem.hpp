@@ -0,0 +1,158 @@
+#pragma once
+
+#include <DGM/classes/Path.hpp>
+#include <DGM/classes/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Moves many agents along their world paths at once
+     *
+     *  Positions, directions and speeds of all agents are stored in
+     * contiguous arrays, one per attribute, so a single update moves every
+     * agent in one branchless loop the compiler can vectorize. Only the
+     * agents that reach a waypoint in a given frame take a slower
+     * per-agent path that selects their next waypoint.
+     *
+     *  Agents share points of their paths, see dgm::Path::getSharedPoints,
+     * so thousands of agents following a handful of routes don't copy
+     * them.
+     */
+    class [[nodiscard]] PathFollowerSystem final
+    {
+    public:
+        using AgentId = std::uint32_t;
+
+    public:
+        PathFollowerSystem() = default;
+        PathFollowerSystem(PathFollowerSystem&&) = default;
+        PathFollowerSystem(const PathFollowerSystem&) = delete;
+
+        PathFollowerSystem& operator=(PathFollowerSystem&&) = default;
+        PathFollowerSystem& operator=(const PathFollowerSystem&) = delete;
+
+    public:
+        /**
+         *  \brief Add an idle agent
+         *
+         *  \param speed Distance travelled per second, must not be
+         * negative
+         *
+         *  \return Id of the agent, ids of removed agents are reused
+         */
+        [[nodiscard]] AgentId
+        addAgent(const sf::Vector2f& position, float speed);
+
+        /**
+         *  \brief Remove an agent, unknown ids are ignored
+         */
+        void removeAgent(AgentId id);
+
+        /**
+         *  \brief Start following a path from its current point
+         *
+         *  Points of the path are shared, not copied. Agent becomes idle
+         * if the path is already traversed.
+         *
+         *  \throw dgm::Exception if there is no agent with such id
+         */
+        void setPath(AgentId id, const dgm::Path<WorldNavpoint>& path);
+
+        /**
+         *  \brief Stop the agent and forget its path
+         *
+         *  \throw dgm::Exception if there is no agent with such id
+         */
+        void stop(AgentId id);
+
+        /**
+         *  \brief Move all agents along their paths
+         *
+         *  Agent that reaches a waypoint continues towards the next one
+         * with the rest of its movement for this frame.
+         *
+         *  \return Ids of agents that reached the last point of their path
+         * during this update, valid until the next call to update
+         */
+        std::span<const AgentId> update(const dgm::Time& time);
+
+        /**
+         *  \throw dgm::Exception if there is no agent with such id
+         */
+        [[nodiscard]] sf::Vector2f getPosition(AgentId id) const;
+
+        /**
+         *  \brief Teleport the agent, it keeps following its path
+         *
+         *  \throw dgm::Exception if there is no agent with such id
+         */
+        void setPosition(AgentId id, const sf::Vector2f& position);
+
+        /**
+         *  \throw dgm::Exception if there is no agent with such id
+         */
+        void setSpeed(AgentId id, float speed);
+
+        /**
+         *  \brief Test whether the agent has a path to follow
+         *
+         *  \throw dgm::Exception if there is no agent with such id
+         */
+        [[nodiscard]] bool isMoving(AgentId id) const;
+
+        [[nodiscard]] std::size_t getAgentCount() const noexcept
+        {
+            return states.size() - freeIds.size();
+        }
+
+    private:
+        enum class [[nodiscard]] State : std::uint8_t
+        {
+            Removed,
+            Idle,
+            Moving
+        };
+
+    private:
+        void requireAgent(AgentId id) const;
+
+        /**
+         *  \brief Head towards the current point of the agent's path
+         */
+        void aimAtCurrentPoint(AgentId id);
+
+        /**
+         *  \brief Select next waypoint of an agent that reached its target
+         * and spend the remaining distance on getting to it
+         */
+        void advanceToNextWaypoint(AgentId id, float remainingDistance);
+
+    private:
+        std::vector<float> positionsX = {};
+        std::vector<float> positionsY = {};
+
+        /// Unit vector towards the current waypoint, computed once per
+        /// waypoint so moving doesn't need any square roots
+        std::vector<float> directionsX = {};
+        std::vector<float> directionsY = {};
+
+        /// Distance to the current waypoint, infinite for idle agents
+        std::vector<float> distances = {};
+
+        std::vector<float> speeds = {};
+        std::vector<State> states = {};
+
+        /// Scratch memory for distances travelled in the current update
+        std::vector<float> steps = {};
+
+        std::vector<dgm::Path<WorldNavpoint>::PointsPtr> routes = {};
+        std::vector<PathCursor> cursors = {};
+
+        std::vector<AgentId> freeIds = {};
+        std::vector<AgentId> arrivals = {};
+    };
+} // namespace dgm
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <DGM/classes/NavMesh.hpp>
+#include <DGM/classes/Path.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Distributes a per-frame node expansion budget among many
+     * dgm::TileNavMesh::PathSearch objects
+     *
+     *  Enqueue searches whenever agents request paths and call update once
+     * per frame. Each update expands at most the configured number of nodes
+     * in total, split evenly among all searches in progress. Budget not
+     * used by searches that finish early is handed over to the others.
+     *
+     *  This trades a few frames of latency for bounded time spent on
+     * pathfinding in every frame.
+     */
+    class [[nodiscard]] PathSearchScheduler final
+    {
+    public:
+        using SearchId = std::uint64_t;
+        using Status = TileNavMesh::PathSearch::Status;
+
+        static constexpr std::size_t DEFAULT_EXPANSION_BUDGET = 4096;
+
+    public:
+        /**
+         *  \param expansionBudget Maximum number of nodes expanded by
+         * a single call to update
+         */
+        explicit PathSearchScheduler(
+            std::size_t expansionBudget = DEFAULT_EXPANSION_BUDGET) noexcept
+            : expansionBudget(expansionBudget)
+        {
+        }
+
+        PathSearchScheduler(PathSearchScheduler&&) = default;
+        PathSearchScheduler(const PathSearchScheduler&) = delete;
+
+    public:
+        /**
+         *  \brief Hand a search over to the scheduler
+         *
+         *  \return Id for querying the status and the result of the search
+         */
+        [[nodiscard]] SearchId enqueue(TileNavMesh::PathSearch&& search);
+
+        /**
+         *  \brief Advance searches in progress, call once per frame
+         *
+         *  \return Number of nodes expanded, at most the expansion budget
+         */
+        std::size_t update();
+
+        /**
+         *  \throw dgm::Exception if there is no search with such id
+         */
+        [[nodiscard]] Status getStatus(SearchId id) const;
+
+        /**
+         *  \brief Get the result of a finished search and forget the search
+         *
+         *  Returns empty optional if the search is not finished yet (and
+         * keeps it) or if the destination is unreachable.
+         *
+         *  \throw dgm::Exception if there is no search with such id
+         */
+        [[nodiscard]] std::optional<dgm::Path<TileNavpoint>>
+        takePath(SearchId id);
+
+        /**
+         *  \brief Forget a search, no matter whether it is finished
+         *
+         *  Unknown ids are ignored.
+         */
+        void cancel(SearchId id);
+
+        /**
+         *  \brief Get number of searches still in progress
+         */
+        [[nodiscard]] std::size_t getPendingCount() const noexcept;
+
+        [[nodiscard]] constexpr std::size_t
+        getExpansionBudget() const noexcept
+        {
+            return expansionBudget;
+        }
+
+        constexpr void setExpansionBudget(std::size_t budget) noexcept
+        {
+            expansionBudget = budget;
+        }
+
+    private:
+        struct [[nodiscard]] Entry final
+        {
+            SearchId id;
+            TileNavMesh::PathSearch search;
+        };
+
+    private:
+        std::size_t expansionBudget;
+        SearchId nextId = 0;
+
+        /// Index of the entry that should be stepped first in next update,
+        /// so the searches take turns if budget is smaller than their count
+        std::size_t nextEntryIndex = 0;
+
+        /// Sorted by id, since ids are increasing
+        std::vector<Entry> entries = {};
+    };
+} // namespace dgm
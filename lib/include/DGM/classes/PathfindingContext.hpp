@@ -0,0 +1,167 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Reusable scratch memory for pathfinding queries
+     *
+     *  Context stores per-tile search state (g-cost, parent and open/closed
+     * state) in flat arrays indexed by y * width + x, together with the open
+     * set of the search, which is an indexed binary heap.
+     *
+     *  Arrays are sized to the mesh only once. Clearing the context between
+     * queries only increments a generation counter, so repeated queries
+     * neither allocate nor traverse any trees. Pass the same context to many
+     * computePath calls to benefit from that.
+     *
+     *  Context can be used with meshes of any size, it grows automatically if
+     * a bigger mesh is queried.
+     *
+     *  \warn Context is not thread-safe, use one context per thread.
+     */
+    class [[nodiscard]] PathfindingContext final
+    {
+    public:
+        using IndexType = std::uint32_t;
+
+        static constexpr IndexType INVALID_INDEX = ~IndexType {};
+
+    public:
+        PathfindingContext() = default;
+
+        /**
+         *  \brief Construct context preallocated for meshes of a given size
+         */
+        explicit PathfindingContext(const sf::Vector2u& meshSize);
+
+        PathfindingContext(PathfindingContext&&) = default;
+        PathfindingContext(const PathfindingContext&) = delete;
+
+        PathfindingContext& operator=(PathfindingContext&&) = default;
+        PathfindingContext& operator=(const PathfindingContext&) = delete;
+
+    public:
+        /**
+         *  \brief Prepare the context for a new search over a mesh
+         *
+         *  All nodes are forgotten in O(1), unless the context has to be
+         * enlarged to fit the mesh.
+         */
+        void beginSearch(const sf::Vector2u& meshSize);
+
+        /**
+         *  \brief Insert a node into the open set or update it if the new
+         * g-cost is not worse than the previous one
+         *
+         *  Closed nodes are never reopened.
+         *
+         *  \return TRUE if the node was inserted or updated
+         */
+        bool openNode(
+            IndexType index, unsigned gcost, unsigned hcost, IndexType parent);
+
+        [[nodiscard]] bool hasOpenNodes() const noexcept
+        {
+            return !heap.empty();
+        }
+
+        /**
+         *  \brief Remove node with the lowest f-cost from the open set and
+         * mark it as closed
+         *
+         *  Ties are broken by h-cost and then by the row-major order of the
+         * tiles, so the searches are deterministic.
+         */
+        [[nodiscard]] IndexType popBestNode();
+
+        [[nodiscard]] bool isOpen(IndexType index) const noexcept
+        {
+            return isVisited(index) && states[index] == NodeState::Open;
+        }
+
+        [[nodiscard]] bool isClosed(IndexType index) const noexcept
+        {
+            return isVisited(index) && states[index] == NodeState::Closed;
+        }
+
+        /**
+         *  \brief Get g-cost of an open or closed node
+         */
+        [[nodiscard]] unsigned getGcost(IndexType index) const noexcept
+        {
+            return gcosts[index];
+        }
+
+        /**
+         *  \brief Get parent of an open or closed node
+         */
+        [[nodiscard]] IndexType getParent(IndexType index) const noexcept
+        {
+            return parents[index];
+        }
+
+        [[nodiscard]] constexpr IndexType
+        toIndex(const sf::Vector2u& coord) const noexcept
+        {
+            return coord.y * width + coord.x;
+        }
+
+        [[nodiscard]] constexpr sf::Vector2u
+        toCoord(IndexType index) const noexcept
+        {
+            return { index % width, index / width };
+        }
+
+    private:
+        enum class NodeState : std::uint8_t
+        {
+            Open,
+            Closed
+        };
+
+        struct [[nodiscard]] HeapEntry final
+        {
+            unsigned fcost;
+            unsigned hcost;
+            IndexType index;
+        };
+
+    private:
+        [[nodiscard]] bool isVisited(IndexType index) const noexcept
+        {
+            return generations[index] == generation;
+        }
+
+        [[nodiscard]] static constexpr bool
+        isBetter(const HeapEntry& a, const HeapEntry& b) noexcept
+        {
+            if (a.fcost != b.fcost) return a.fcost < b.fcost;
+            if (a.hcost != b.hcost) return a.hcost < b.hcost;
+            return a.index < b.index;
+        }
+
+        void placeEntry(std::size_t position, const HeapEntry& entry) noexcept
+        {
+            heap[position] = entry;
+            heapPositions[entry.index] = static_cast<IndexType>(position);
+        }
+
+        void siftUp(std::size_t position) noexcept;
+
+        void siftDown(std::size_t position) noexcept;
+
+    private:
+        unsigned width = 0;
+        std::uint32_t generation = 0;
+        std::vector<std::uint32_t> generations = {};
+        std::vector<NodeState> states = {};
+        std::vector<unsigned> gcosts = {};
+        std::vector<IndexType> parents = {};
+        std::vector<IndexType> heapPositions = {};
+        std::vector<HeapEntry> heap = {};
+    };
+} // namespace dgm
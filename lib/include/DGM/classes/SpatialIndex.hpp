@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <concepts>
 #include <functional>
+#include <utility>
 #include <vector>
 
 namespace dgm
@@ -26,6 +27,7 @@ namespace dgm
     public:
         using IndexingType = IndexType;
         using IndexListType = std::vector<IndexType>;
+        using PairListType = std::vector<std::pair<IndexType, IndexType>>;
 
     public:
         constexpr SpatialIndex(
@@ -124,6 +126,33 @@ namespace dgm
             return result;
         }
 
+        /**
+         * \brief Get all pairs of items that might be colliding with each
+         * other, which are items sharing at least one cell of the grid
+         *
+         * Each pair is reported once with the smaller id first. Same output
+         * as dgm::SweepAndPrune::getCandidatePairs gives, so both can be
+         * benchmarked against each other.
+         */
+        [[nodiscard]] PairListType getCandidatePairs() const
+        {
+            auto&& result = PairListType {};
+            for (auto&& cell : grid)
+            {
+                for (unsigned i = 0; i < cell.size(); i++)
+                {
+                    for (unsigned j = i + 1; j < cell.size(); j++)
+                        result.push_back(std::minmax(cell[i], cell[j]));
+                }
+            }
+
+            // Items spanning multiple cells are paired in each of them
+            std::sort(result.begin(), result.end());
+            result.erase(
+                std::unique(result.begin(), result.end()), result.end());
+            return result;
+        }
+
         [[nodiscard]] const constexpr dgm::Rect&
         getBoundingBox() const noexcept
         {
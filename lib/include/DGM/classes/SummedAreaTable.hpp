@@ -0,0 +1,121 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     *  \brief Summed-area table (integral image) of impassable tiles of
+     * a mesh
+     *
+     *  Each entry holds the number of impassable tiles above and to the
+     * left of a tile, so the number of impassable tiles within any
+     * rectangle is computed from four lookups regardless of its size.
+     * Useful for probing large areas, like validating spawn positions or
+     * looking for cover.
+     *
+     *  Call update whenever the mesh changes. Changing a single tile costs
+     * a single addition for each tile below and to the right of it.
+     */
+    class [[nodiscard]] SummedAreaTable final
+    {
+    public:
+        explicit SummedAreaTable(const dgm::Mesh& mesh);
+
+        SummedAreaTable(SummedAreaTable&&) = default;
+        SummedAreaTable(const SummedAreaTable&) = delete;
+
+        SummedAreaTable& operator=(SummedAreaTable&&) = default;
+        SummedAreaTable& operator=(const SummedAreaTable&) = delete;
+
+    public:
+        /**
+         *  \brief Update sums after some tiles of the mesh changed
+         *
+         *  Sums of all tiles below and to the right of the top left corner
+         * are computed again.
+         *
+         *  \param topLeft Top left corner of inclusive rectangle containing
+         * all changed tiles
+         *  \param bottomRight Bottom right corner of the rectangle
+         */
+        void update(
+            const dgm::Mesh& mesh,
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight);
+
+        /**
+         *  \brief Update sums after a single tile of the mesh changed
+         */
+        void update(const dgm::Mesh& mesh, const sf::Vector2u& tile);
+
+        /**
+         *  \brief Count impassable tiles within inclusive rectangle in O(1)
+         *
+         *  Rectangle must lie within the mesh.
+         */
+        [[nodiscard]] std::uint32_t countSolidTiles(
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight) const noexcept
+        {
+            // Intermediate results can wrap around, the final one can't
+            return getSum(bottomRight.x + 1, bottomRight.y + 1)
+                   - getSum(topLeft.x, bottomRight.y + 1)
+                   - getSum(bottomRight.x + 1, topLeft.y)
+                   + getSum(topLeft.x, topLeft.y);
+        }
+
+        /**
+         *  \brief Test whether inclusive rectangle contains any impassable
+         * tile in O(1)
+         */
+        [[nodiscard]] bool hasSolidTile(
+            const sf::Vector2u& topLeft,
+            const sf::Vector2u& bottomRight) const noexcept
+        {
+            return countSolidTiles(topLeft, bottomRight) > 0;
+        }
+
+        [[nodiscard]] constexpr const sf::Vector2u&
+        getDataSize() const noexcept
+        {
+            return dataSize;
+        }
+
+        /**
+         *  \brief Version of the mesh the sums were computed from
+         */
+        [[nodiscard]] constexpr const MeshVersion&
+        getMeshVersion() const noexcept
+        {
+            return meshVersion;
+        }
+
+    private:
+        /**
+         *  \brief Get number of impassable tiles with coordinates lower
+         * than x and y
+         */
+        [[nodiscard]] std::uint32_t
+        getSum(unsigned x, unsigned y) const noexcept
+        {
+            return sums[y * (dataSize.x + 1) + x];
+        }
+
+        /**
+         *  \brief Compute sums of all tiles below and to the right of
+         * a tile, sums above and to the left of it must be up to date
+         */
+        void computeSums(const dgm::Mesh& mesh, const sf::Vector2u& topLeft);
+
+    private:
+        sf::Vector2u dataSize;
+        MeshVersion meshVersion;
+
+        /// Extra zero row and column on top and on the left avoid branches
+        std::vector<std::uint32_t> sums = {};
+    };
+} // namespace dgm
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <DGM/classes/Objects.hpp>
+#include <DGM/classes/SpatialIndex.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dgm
+{
+    /**
+     * \brief Broadphase keeping bounding boxes sorted by their left edges
+     *
+     * Alternative to dgm::SpatialIndex for scenes where sizes of objects
+     * vary a lot or where objects mostly move along one axis. A grid is
+     * either too coarse for such scenes or big objects end up in a lot of
+     * its cells, while sort and sweep does not care about either.
+     *
+     * Lookup is manipulated the same way as dgm::SpatialIndex, so both can
+     * be swapped for each other. On top of that, moving an object with
+     * update only shifts it by as many places as the number of boxes its
+     * left edge moved past. Objects move just a bit between frames, so
+     * keeping the boxes sorted costs about as much as a single pass over
+     * them.
+     *
+     * Recommended way of using this structure:
+     *
+     * \code
+     * for (auto&& [item, id] : items)
+     *     broadphase.update(id, item.collisionBox);
+     *
+     * for (auto&& [first, second] : broadphase.getCandidatePairs())
+     * {
+     *     // compute collision of items[first] and items[second]
+     * }
+     * \endcode
+     *
+     * Ids are used to index internal array, so they should be small
+     * numbers, like indices of dgm::DynamicBuffer.
+     */
+    template<typename IndexType = std::size_t>
+    class [[nodiscard]] SweepAndPrune
+    {
+    public:
+        using IndexingType = IndexType;
+        using IndexListType = std::vector<IndexType>;
+        using PairListType = std::vector<std::pair<IndexType, IndexType>>;
+
+    public:
+        SweepAndPrune() = default;
+        SweepAndPrune(SweepAndPrune&&) = default;
+        SweepAndPrune(const SweepAndPrune&) = delete;
+        ~SweepAndPrune() = default;
+
+        SweepAndPrune& operator=(SweepAndPrune&&) = default;
+        SweepAndPrune& operator=(const SweepAndPrune&) = delete;
+
+    public:
+        /**
+         * \brief Remove an item from the lookup so it is not returned by
+         * getOverlapCandidates nor getCandidatePairs
+         *
+         * Box is only accepted for compatibility with dgm::SpatialIndex,
+         * position of the item within the lookup is known.
+         */
+        template<AaBbType AABB>
+        void removeFromLookup(IndexType id, const AABB&)
+        {
+            if (!contains(id)) return;
+
+            const std::size_t slot = slots[id];
+            entries.erase(entries.begin() + slot);
+            slots[id] = NO_SLOT;
+            for (std::size_t i = slot; i < entries.size(); ++i)
+                slots[entries[i].id] = i;
+        }
+
+        /**
+         * \brief Insert an item into the lookup
+         *
+         * Item must not be in the lookup already, use update to move it.
+         */
+        template<AaBbType AABB>
+        void returnToLookup(IndexType id, const AABB& box)
+        {
+            assert(!contains(id) && "Item is already in the lookup");
+            if (slots.size() <= id) slots.resize(id + 1, NO_SLOT);
+
+            slots[id] = entries.size();
+            entries.push_back(Entry { .bounds = {}, .id = id });
+            place(slots[id], getBounds(box));
+        }
+
+        /**
+         * \brief Move an item within the lookup, inserting it if it is not
+         * there yet
+         *
+         * Costs a single comparison for each box the left edge of the item
+         * moved past since the last update.
+         */
+        template<AaBbType AABB>
+        void update(IndexType id, const AABB& box)
+        {
+            if (!contains(id))
+                returnToLookup(id, box);
+            else
+                place(slots[id], getBounds(box));
+        }
+
+        /**
+         * \brief Get ids of items whose bounding boxes overlap with given
+         * bounding box
+         *
+         * Unlike dgm::SpatialIndex, returned items are not just nearby, their
+         * bounding boxes overlap with the box. Ids are not sorted.
+         */
+        template<AaBbType AABB>
+        [[nodiscard]] std::vector<IndexType>
+        getOverlapCandidates(const AABB& box) const
+        {
+            const auto bounds = getBounds(box);
+
+            // No box wider than maxWidth can reach the query from further
+            // left than this
+            const auto first = std::lower_bound(
+                entries.begin(),
+                entries.end(),
+                bounds.left - maxWidth,
+                [](const Entry& entry, float left)
+                { return entry.bounds.left < left; });
+
+            auto&& result = std::vector<IndexType> {};
+            for (auto itr = first;
+                 itr != entries.end() && itr->bounds.left <= bounds.right;
+                 ++itr)
+            {
+                if (overlaps(itr->bounds, bounds)) result.push_back(itr->id);
+            }
+            return result;
+        }
+
+        /**
+         * \brief Get all pairs of items whose bounding boxes overlap
+         *
+         * Each pair is reported once with the smaller id first. Pairs are
+         * not sorted.
+         */
+        [[nodiscard]] PairListType getCandidatePairs() const
+        {
+            auto&& result = PairListType {};
+
+            // Boxes are sorted by their left edges, so the sweep can stop
+            // at the first box starting right of the current one
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+                const auto& current = entries[i];
+                for (std::size_t j = i + 1; j < entries.size()
+                                            && entries[j].bounds.left
+                                                   <= current.bounds.right;
+                     ++j)
+                {
+                    if (!overlaps(current.bounds, entries[j].bounds))
+                        continue;
+
+                    result.push_back(std::minmax(current.id, entries[j].id));
+                }
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] bool contains(IndexType id) const noexcept
+        {
+            return id < slots.size() && slots[id] != NO_SLOT;
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+            return entries.size();
+        }
+
+        void clear()
+        {
+            entries.clear();
+            slots.clear();
+            maxWidth = 0.f;
+        }
+
+    private:
+        struct Bounds
+        {
+            float left, top, right, bottom;
+        };
+
+        struct Entry
+        {
+            Bounds bounds;
+            IndexType id;
+        };
+
+        static constexpr std::size_t NO_SLOT =
+            std::numeric_limits<std::size_t>::max();
+
+    private:
+        [[nodiscard]] static constexpr Bounds
+        getBounds(const sf::Vector2f& point) noexcept
+        {
+            return { point.x, point.y, point.x, point.y };
+        }
+
+        [[nodiscard]] static Bounds getBounds(const dgm::Circle& box) noexcept
+        {
+            const auto& center = box.getPosition();
+            const float radius = box.getRadius();
+            return { center.x - radius,
+                     center.y - radius,
+                     center.x + radius,
+                     center.y + radius };
+        }
+
+        [[nodiscard]] static Bounds getBounds(const dgm::Rect& box) noexcept
+        {
+            const auto& position = box.getPosition();
+            const auto& size = box.getSize();
+            return { position.x,
+                     position.y,
+                     position.x + size.x,
+                     position.y + size.y };
+        }
+
+        /**
+         * \brief Touching boxes overlap, same as in dgm::Collision
+         */
+        [[nodiscard]] static constexpr bool
+        overlaps(const Bounds& a, const Bounds& b) noexcept
+        {
+            return a.left <= b.right && b.left <= a.right && a.top <= b.bottom
+                   && b.top <= a.bottom;
+        }
+
+        /**
+         * \brief Set bounds of an entry and move it where it belongs
+         */
+        void place(std::size_t slot, const Bounds& bounds) noexcept
+        {
+            entries[slot].bounds = bounds;
+            maxWidth = std::max(maxWidth, bounds.right - bounds.left);
+
+            // Single step of insertion sort in whichever direction the item
+            // moved
+            while (slot > 0 && bounds.left < entries[slot - 1].bounds.left)
+            {
+                swapEntries(slot - 1, slot);
+                --slot;
+            }
+
+            while (slot + 1 < entries.size()
+                   && entries[slot + 1].bounds.left < bounds.left)
+            {
+                swapEntries(slot, slot + 1);
+                ++slot;
+            }
+        }
+
+        void swapEntries(std::size_t a, std::size_t b) noexcept
+        {
+            std::swap(entries[a], entries[b]);
+            slots[entries[a].id] = a;
+            slots[entries[b].id] = b;
+        }
+
+    private:
+        /// Sorted by left edges of the bounds
+        std::vector<Entry> entries = {};
+        /// Position of each id within entries
+        std::vector<std::size_t> slots = {};
+        /// Width of the widest box ever inserted
+        float maxWidth = 0.f;
+    };
+} // namespace dgm
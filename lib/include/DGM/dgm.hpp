@@ -14,15 +14,19 @@
 #include "classes/Clip.hpp"
 #include "classes/Collision.hpp"
 #include "classes/Controller.hpp"
+#include "classes/DistanceField.hpp"
 #include "classes/DynamicBuffer.hpp"
 #include "classes/Error.hpp"
 #include "classes/JsonLoader.hpp"
 #include "classes/LoaderInterface.hpp"
 #include "classes/Math.hpp"
 #include "classes/Objects.hpp"
+#include "classes/OccupancyMesh.hpp"
 #include "classes/ResourceManager.hpp"
 #include "classes/SpatialBuffer.hpp"
 #include "classes/StaticBuffer.hpp"
+#include "classes/SummedAreaTable.hpp"
+#include "classes/SweepAndPrune.hpp"
 #include "classes/TextureAtlas.hpp"
 #include "classes/TileMap.hpp"
 #include "classes/Time.hpp"
@@ -34,8 +38,16 @@
 #include "classes/ParticleSystemRenderer.hpp"
 
 // Navigation
+#include "classes/ClearanceMap.hpp"
+#include "classes/ConnectedComponents.hpp"
+#include "classes/FlowField.hpp"
+#include "classes/HierarchicalNavMesh.hpp"
 #include "classes/NavMesh.hpp"
 #include "classes/Path.hpp"
+#include "classes/PathCache.hpp"
+#include "classes/PathFollowerSystem.hpp"
+#include "classes/PathSearchScheduler.hpp"
+#include "classes/PathfindingContext.hpp"
 #include "classes/Raycaster.hpp"
 
 // Helpers
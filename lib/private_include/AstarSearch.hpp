@@ -0,0 +1,121 @@
+#pragma once
+
+#include <DGM/classes/PathfindingContext.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dgm
+{
+    namespace priv
+    {
+        /**
+         *  Callback that is given a context and an index of freshly closed
+         * node and is supposed to insert all neighbors of that node into the
+         * open set
+         */
+        template<class T>
+        concept ExpandNodeCallback = std::invocable<
+            T,
+            dgm::PathfindingContext&,
+            dgm::PathfindingContext::IndexType>;
+
+        /**
+         *  Prepares the context for a search and opens the start node
+         */
+        inline void beginAstarSearch(
+            dgm::PathfindingContext& context,
+            const sf::Vector2u& startCoord,
+            const sf::Vector2u& meshSize,
+            unsigned startHcost)
+        {
+            context.beginSearch(meshSize);
+
+            const auto startIndex = context.toIndex(startCoord);
+            context.openNode(startIndex, 0, startHcost, startIndex);
+        }
+
+        /**
+         *  Continues a search started by beginAstarSearch, closing at most
+         * 'budget' nodes. Budget is decreased by the number of closed nodes.
+         *
+         *  Returns true if the destination was reached. Otherwise, the search
+         * can be resumed later as long as the context still has open nodes.
+         */
+        template<ExpandNodeCallback Callback>
+        bool continueAstarSearch(
+            dgm::PathfindingContext& context,
+            const sf::Vector2u& destinationCoord,
+            std::size_t& budget,
+            Callback&& expandNode)
+        {
+            using IndexType = dgm::PathfindingContext::IndexType;
+
+            const IndexType destinationIndex =
+                context.toIndex(destinationCoord);
+
+            while (budget > 0 && context.hasOpenNodes())
+            {
+                const IndexType index = context.popBestNode();
+                --budget;
+                if (index == destinationIndex) return true;
+
+                expandNode(context, index);
+            }
+
+            return false;
+        }
+
+        /**
+         *  Returns true if the destination was reached. In that case, path
+         * can be reconstructed by following the parents stored in the
+         * context.
+         */
+        template<ExpandNodeCallback Callback>
+        bool astarSearch(
+            dgm::PathfindingContext& context,
+            const sf::Vector2u& startCoord,
+            const sf::Vector2u& destinationCoord,
+            const sf::Vector2u& meshSize,
+            unsigned startHcost,
+            Callback&& expandNode)
+        {
+            beginAstarSearch(context, startCoord, meshSize, startHcost);
+
+            std::size_t budget = std::numeric_limits<std::size_t>::max();
+            return continueAstarSearch(
+                context,
+                destinationCoord,
+                budget,
+                std::forward<Callback>(expandNode));
+        }
+
+        /**
+         *  Returns coordinates of the nodes on the path found by the last
+         * search, excluding 'from' coord and including 'to' coord
+         */
+        [[nodiscard]] inline std::vector<sf::Vector2u> reconstructPath(
+            const dgm::PathfindingContext& context,
+            const sf::Vector2u& from,
+            const sf::Vector2u& to)
+        {
+            using IndexType = dgm::PathfindingContext::IndexType;
+
+            const IndexType fromIndex = context.toIndex(from);
+
+            std::vector<sf::Vector2u> points;
+            for (IndexType index = context.toIndex(to); index != fromIndex;
+                 index = context.getParent(index))
+            {
+                points.push_back(context.toCoord(index));
+            }
+            std::reverse(points.begin(), points.end());
+
+            return points;
+        }
+    } // namespace priv
+} // namespace dgm
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <DGM/classes/ClearanceMap.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+namespace dgm
+{
+    namespace priv
+    {
+        /**
+         *  Read-only view of a dgm::Mesh used by the tile-based searches
+         *
+         *  All coordinates are signed, so neighbors of border tiles can be
+         * queried safely, tiles outside of the mesh are never walkable.
+         * Diagonal steps are only allowed if both adjacent straight tiles are
+         * walkable (no corner cutting).
+         *
+         *  If a clearance map is given, tiles are only walkable for agents
+         * that fit there.
+         */
+        class [[nodiscard]] TileGrid final
+        {
+        public:
+            using Connectivity = dgm::TileNavMesh::Connectivity;
+
+            // Costs are scaled so diagonal steps can be represented by
+            // integers
+            static constexpr unsigned STRAIGHT_COST = 100;
+            static constexpr unsigned DIAGONAL_COST = 141;
+
+            static constexpr std::array<sf::Vector2i, 4> STRAIGHT_DIRECTIONS = {
+                sf::Vector2i(0, -1),
+                sf::Vector2i(0, 1),
+                sf::Vector2i(-1, 0),
+                sf::Vector2i(1, 0),
+            };
+
+            static constexpr std::array<sf::Vector2i, 4> DIAGONAL_DIRECTIONS = {
+                sf::Vector2i(-1, -1),
+                sf::Vector2i(1, -1),
+                sf::Vector2i(-1, 1),
+                sf::Vector2i(1, 1),
+            };
+
+        public:
+            TileGrid(
+                const dgm::Mesh& mesh,
+                Connectivity connectivity,
+                const dgm::ClearanceMap* clearance = nullptr,
+                unsigned agentSize = 1) noexcept
+                : mesh(mesh)
+                , size(mesh.getDataSize())
+                , connectivity(connectivity)
+                , clearance(agentSize > 1 ? clearance : nullptr)
+                , agentSize(agentSize)
+            {
+            }
+
+        public:
+            [[nodiscard]] bool isWalkable(int x, int y) const noexcept
+            {
+                if (x < 0 || y < 0 || x >= size.x || y >= size.y) return false;
+
+                const auto tile = sf::Vector2u(
+                    static_cast<unsigned>(x), static_cast<unsigned>(y));
+                return clearance ? clearance->canFit(tile, agentSize)
+                                 : mesh[tile] <= 0;
+            }
+
+            [[nodiscard]] bool isWalkable(const sf::Vector2i& p) const noexcept
+            {
+                return isWalkable(p.x, p.y);
+            }
+
+            /**
+             *  Test whether it is possible to move from a tile to its
+             * neighbor in a given direction
+             */
+            [[nodiscard]] bool canStep(
+                const sf::Vector2i& from,
+                const sf::Vector2i& direction) const noexcept
+            {
+                if (!isWalkable(from + direction)) return false;
+                if (direction.x == 0 || direction.y == 0) return true;
+                return connectivity == Connectivity::EightWay
+                       && isWalkable(from.x + direction.x, from.y)
+                       && isWalkable(from.x, from.y + direction.y);
+            }
+
+            [[nodiscard]] constexpr Connectivity
+            getConnectivity() const noexcept
+            {
+                return connectivity;
+            }
+
+            [[nodiscard]] constexpr const sf::Vector2i&
+            getSize() const noexcept
+            {
+                return size;
+            }
+
+            /**
+             *  Cost of the shortest path between two tiles on an empty grid.
+             * Between two subsequent jump points, it is the exact cost.
+             */
+            [[nodiscard]] unsigned getDistance(
+                const sf::Vector2i& a, const sf::Vector2i& b) const noexcept
+            {
+                const unsigned dx = static_cast<unsigned>(std::abs(a.x - b.x));
+                const unsigned dy = static_cast<unsigned>(std::abs(a.y - b.y));
+
+                if (connectivity == Connectivity::FourWay)
+                    return (dx + dy) * STRAIGHT_COST;
+
+                return std::min(dx, dy) * DIAGONAL_COST
+                       + (std::max(dx, dy) - std::min(dx, dy)) * STRAIGHT_COST;
+            }
+
+            [[nodiscard]] constexpr static unsigned
+            getStepCost(const sf::Vector2i& direction) noexcept
+            {
+                return direction.x != 0 && direction.y != 0 ? DIAGONAL_COST
+                                                            : STRAIGHT_COST;
+            }
+
+        private:
+            const dgm::Mesh& mesh;
+            sf::Vector2i size;
+            Connectivity connectivity;
+            const dgm::ClearanceMap* clearance;
+            unsigned agentSize;
+        };
+
+        [[nodiscard]] constexpr int sign(int value) noexcept
+        {
+            return (0 < value) - (value < 0);
+        }
+
+        [[nodiscard]] constexpr sf::Vector2i
+        getDirection(const sf::Vector2i& from, const sf::Vector2i& to) noexcept
+        {
+            return { sign(to.x - from.x), sign(to.y - from.y) };
+        }
+
+    } // namespace priv
+} // namespace dgm
@@ -0,0 +1,71 @@
+#include "DGM/classes/ClearanceMap.hpp"
+#include <algorithm>
+#include <limits>
+
+static_assert(
+    dgm::ClearanceMap::MAX_CLEARANCE
+    == std::numeric_limits<std::uint8_t>::max());
+
+dgm::ClearanceMap::ClearanceMap(const dgm::Mesh& mesh)
+    : dataSize(mesh.getDataSize())
+    , meshVersion(mesh.getVersion())
+    , clearance(std::size_t { dataSize.x } * dataSize.y, 0)
+{
+    if (dataSize.x == 0 || dataSize.y == 0) return;
+    computeClearance(mesh, { 0u, 0u }, dataSize - sf::Vector2u(1u, 1u));
+}
+
+void dgm::ClearanceMap::update(
+    const dgm::Mesh& mesh,
+    const sf::Vector2u& topLeft,
+    const sf::Vector2u& bottomRight)
+{
+    if (mesh.getDataSize() != dataSize)
+    {
+        *this = ClearanceMap(mesh);
+        return;
+    }
+
+    // Clearance of a tile only depends on the tiles below and to the right
+    // of it, up to the maximum clearance away
+    computeClearance(
+        mesh,
+        { topLeft.x - std::min(topLeft.x, MAX_CLEARANCE),
+          topLeft.y - std::min(topLeft.y, MAX_CLEARANCE) },
+        { std::min(bottomRight.x, dataSize.x - 1),
+          std::min(bottomRight.y, dataSize.y - 1) });
+    meshVersion = mesh.getVersion();
+}
+
+void dgm::ClearanceMap::computeClearance(
+    const dgm::Mesh& mesh,
+    const sf::Vector2u& topLeft,
+    const sf::Vector2u& bottomRight)
+{
+    auto&& at = [&](unsigned x, unsigned y) -> unsigned
+    {
+        return x < dataSize.x && y < dataSize.y
+                   ? clearance[y * dataSize.x + x]
+                   : 0u;
+    };
+
+    // Largest square at a tile is one larger than the smallest of the
+    // squares at its right, bottom and bottom right neighbors
+    for (unsigned y = bottomRight.y + 1; y-- > topLeft.y;)
+    {
+        for (unsigned x = bottomRight.x + 1; x-- > topLeft.x;)
+        {
+            const unsigned index = y * dataSize.x + x;
+            if (mesh[{ x, y }] > 0)
+            {
+                clearance[index] = 0;
+                continue;
+            }
+
+            const unsigned smallest = std::min(
+                { at(x + 1, y), at(x, y + 1), at(x + 1, y + 1) });
+            clearance[index] = static_cast<std::uint8_t>(
+                std::min(smallest + 1, MAX_CLEARANCE));
+        }
+    }
+}
@@ -1,6 +1,18 @@
 #include <DGM/classes/Collision.hpp>
 #include <DGM/classes/Math.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <utility>
+
+using CircleBatch = dgm::Collision::CircleBatch;
+using RectBatch = dgm::Collision::RectBatch;
 
 bool dgm::Collision::basic(const dgm::Rect& rect, const sf::Vector2f& point)
 {
@@ -87,6 +99,219 @@ bool dgm::Collision::basic(const dgm::Rect& A, const dgm::Rect& B)
     return false;
 }
 
+/**
+ *  Packs result of test for each index of the batch into bits of hits.
+ *  Tests are branchless lambdas reading raw pointers, so the compiler can
+ *  vectorize the loop for whatever instruction set the library is built
+ *  for.
+ */
+template<class Test>
+static void fillHitMask(std::size_t count, std::uint64_t* hits, Test&& test)
+{
+    constexpr std::size_t WORD_BITS = dgm::Collision::HIT_MASK_WORD_BITS;
+    for (std::size_t begin = 0; begin < count; begin += WORD_BITS)
+    {
+        const std::size_t wordSize = std::min(WORD_BITS, count - begin);
+
+        // Tests only vectorize when their results are stored as bytes,
+        // packing the bytes into bits is a separate pass
+        std::uint8_t bytes[WORD_BITS] = {};
+        for (std::size_t i = 0; i < wordSize; ++i)
+            bytes[i] = test(begin + i) ? 1u : 0u;
+
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < WORD_BITS; ++i)
+            word |= std::uint64_t { bytes[i] } << i;
+        hits[begin / WORD_BITS] = word;
+    }
+}
+
+template<class Test>
+static std::size_t appendHitIndices(
+    std::size_t count, std::vector<std::size_t>& hitIndices, Test&& test)
+{
+    constexpr std::size_t WORD_BITS = dgm::Collision::HIT_MASK_WORD_BITS;
+
+    const std::size_t initialSize = hitIndices.size();
+    for (std::size_t begin = 0; begin < count; begin += WORD_BITS)
+    {
+        std::uint64_t word = 0;
+        fillHitMask(
+            std::min(WORD_BITS, count - begin),
+            &word,
+            [&](std::size_t i) { return test(begin + i); });
+
+        // Only set bits are visited, so sparse hits cost next to nothing
+        for (; word != 0; word &= word - 1)
+            hitIndices.push_back(begin + std::countr_zero(word));
+    }
+    return hitIndices.size() - initialSize;
+}
+
+/**
+ *  Tests below must give exactly the same results as the single pair
+ *  overloads of dgm::Collision::basic
+ */
+[[nodiscard]] static auto makeBatchTest(
+    const dgm::Circle& circle, const CircleBatch& batch)
+{
+    assert(batch.y.size() == batch.size());
+    assert(batch.radius.size() == batch.size());
+
+    return [cx = circle.getPosition().x,
+            cy = circle.getPosition().y,
+            cr = circle.getRadius(),
+            xs = batch.x.data(),
+            ys = batch.y.data(),
+            rs = batch.radius.data()](std::size_t i)
+    {
+        const float dX = cx - xs[i];
+        const float dY = cy - ys[i];
+        const float rSum = cr + rs[i];
+        return (dX * dX + dY * dY) < (rSum * rSum);
+    };
+}
+
+[[nodiscard]] static auto makeBatchTest(
+    const dgm::Circle& circle, const RectBatch& batch)
+{
+    assert(batch.y.size() == batch.size());
+    assert(batch.width.size() == batch.size());
+    assert(batch.height.size() == batch.size());
+
+    return [cx = circle.getPosition().x,
+            cy = circle.getPosition().y,
+            cr = circle.getRadius(),
+            xs = batch.x.data(),
+            ys = batch.y.data(),
+            ws = batch.width.data(),
+            hs = batch.height.data()](std::size_t i)
+    {
+        // Closest point of the rectangle, same as the branchy version
+        const float dX = cx - std::min(std::max(cx, xs[i]), xs[i] + ws[i]);
+        const float dY = cy - std::min(std::max(cy, ys[i]), ys[i] + hs[i]);
+        return (dX * dX + dY * dY) < cr * cr;
+    };
+}
+
+[[nodiscard]] static auto makeBatchTest(
+    const dgm::Rect& rect, const CircleBatch& batch)
+{
+    assert(batch.y.size() == batch.size());
+    assert(batch.radius.size() == batch.size());
+
+    return [rx = rect.getPosition().x,
+            ry = rect.getPosition().y,
+            rw = rect.getSize().x,
+            rh = rect.getSize().y,
+            xs = batch.x.data(),
+            ys = batch.y.data(),
+            rs = batch.radius.data()](std::size_t i)
+    {
+        const float dX = xs[i] - std::min(std::max(xs[i], rx), rx + rw);
+        const float dY = ys[i] - std::min(std::max(ys[i], ry), ry + rh);
+        return (dX * dX + dY * dY) < rs[i] * rs[i];
+    };
+}
+
+[[nodiscard]] static auto makeBatchTest(
+    const dgm::Rect& rect, const RectBatch& batch)
+{
+    assert(batch.y.size() == batch.size());
+    assert(batch.width.size() == batch.size());
+    assert(batch.height.size() == batch.size());
+
+    const auto halfSize = rect.getSize() / 2.f;
+    const auto center = rect.getPosition() + halfSize;
+    return [cx = center.x,
+            cy = center.y,
+            hw = halfSize.x,
+            hh = halfSize.y,
+            xs = batch.x.data(),
+            ys = batch.y.data(),
+            ws = batch.width.data(),
+            hs = batch.height.data()](std::size_t i)
+    {
+        const float halfWidth = ws[i] / 2.f;
+        const float halfHeight = hs[i] / 2.f;
+        const float dX = std::abs(cx - (xs[i] + halfWidth));
+        const float dY = std::abs(cy - (ys[i] + halfHeight));
+        return (dX <= hw + halfWidth) & (dY <= hh + halfHeight);
+    };
+}
+
+void dgm::Collision::basic(
+    const dgm::Circle& circle,
+    const CircleBatch& batch,
+    std::span<std::uint64_t> hits)
+{
+    assert(hits.size() >= getHitMaskSize(batch.size()));
+    fillHitMask(batch.size(), hits.data(), makeBatchTest(circle, batch));
+}
+
+void dgm::Collision::basic(
+    const dgm::Circle& circle,
+    const RectBatch& batch,
+    std::span<std::uint64_t> hits)
+{
+    assert(hits.size() >= getHitMaskSize(batch.size()));
+    fillHitMask(batch.size(), hits.data(), makeBatchTest(circle, batch));
+}
+
+void dgm::Collision::basic(
+    const dgm::Rect& rect,
+    const CircleBatch& batch,
+    std::span<std::uint64_t> hits)
+{
+    assert(hits.size() >= getHitMaskSize(batch.size()));
+    fillHitMask(batch.size(), hits.data(), makeBatchTest(rect, batch));
+}
+
+void dgm::Collision::basic(
+    const dgm::Rect& rect,
+    const RectBatch& batch,
+    std::span<std::uint64_t> hits)
+{
+    assert(hits.size() >= getHitMaskSize(batch.size()));
+    fillHitMask(batch.size(), hits.data(), makeBatchTest(rect, batch));
+}
+
+std::size_t dgm::Collision::collectHits(
+    const dgm::Circle& circle,
+    const CircleBatch& batch,
+    std::vector<std::size_t>& hitIndices)
+{
+    return appendHitIndices(
+        batch.size(), hitIndices, makeBatchTest(circle, batch));
+}
+
+std::size_t dgm::Collision::collectHits(
+    const dgm::Circle& circle,
+    const RectBatch& batch,
+    std::vector<std::size_t>& hitIndices)
+{
+    return appendHitIndices(
+        batch.size(), hitIndices, makeBatchTest(circle, batch));
+}
+
+std::size_t dgm::Collision::collectHits(
+    const dgm::Rect& rect,
+    const CircleBatch& batch,
+    std::vector<std::size_t>& hitIndices)
+{
+    return appendHitIndices(
+        batch.size(), hitIndices, makeBatchTest(rect, batch));
+}
+
+std::size_t dgm::Collision::collectHits(
+    const dgm::Rect& rect,
+    const RectBatch& batch,
+    std::vector<std::size_t>& hitIndices)
+{
+    return appendHitIndices(
+        batch.size(), hitIndices, makeBatchTest(rect, batch));
+}
+
 static sf::IntRect
 normalizeBoundaries(const sf::IntRect& src, const dgm::Mesh& mesh)
 {
@@ -172,6 +397,89 @@ bool dgm::Collision::basic(
     return false;
 }
 
+/**
+ *  Inclusive range of tiles overlapped by a body, clamped to the mesh.
+ *  Empty optional if the body lies completely outside of the mesh.
+ */
+[[nodiscard]] static std::optional<std::pair<sf::Vector2u, sf::Vector2u>>
+getTileRange(const sf::FloatRect& body, const dgm::OccupancyMesh& mesh)
+{
+    const auto meshSize = sf::Vector2i(mesh.getDataSize());
+    const auto tileSize = sf::Vector2f(mesh.getVoxelSize());
+
+    // Rounded down, so bodies left of or above the mesh get negative tiles
+    auto&& getTile = [&](const sf::Vector2f& point)
+    {
+        return sf::Vector2i(
+            static_cast<int>(std::floor(point.x / tileSize.x)),
+            static_cast<int>(std::floor(point.y / tileSize.y)));
+    };
+    const auto from = getTile(body.position);
+    const auto to = getTile(body.position + body.size);
+
+    if (to.x < 0 || to.y < 0 || from.x >= meshSize.x || from.y >= meshSize.y
+        || from.x > to.x || from.y > to.y)
+        return std::nullopt;
+
+    return std::pair {
+        sf::Vector2u(
+            static_cast<unsigned>(std::max(from.x, 0)),
+            static_cast<unsigned>(std::max(from.y, 0))),
+        sf::Vector2u(
+            static_cast<unsigned>(std::min(to.x, meshSize.x - 1)),
+            static_cast<unsigned>(std::min(to.y, meshSize.y - 1)))
+    };
+}
+
+bool dgm::Collision::basic(
+    const dgm::OccupancyMesh& A,
+    const dgm::Circle& B,
+    std::size_t* meshHitPosition)
+{
+    const sf::Vector2f radius(B.getRadius(), B.getRadius());
+    const auto range = getTileRange(
+        sf::FloatRect(B.getPosition() - radius - A.getPosition(), radius * 2.f),
+        A);
+    if (!range) return false;
+
+    const sf::Vector2f tileSize(A.getVoxelSize());
+    dgm::Rect box(sf::Vector2f(0.f, 0.f), tileSize);
+
+    const auto hit = A.findOccupiedTile(
+        range->first,
+        range->second,
+        [&](const sf::Vector2u& tile)
+        {
+            box.setPosition(
+                sf::Vector2f(
+                    float(tile.x) * tileSize.x, float(tile.y) * tileSize.y)
+                + A.getPosition());
+            return dgm::Collision::basic(box, B);
+        });
+    if (!hit) return false;
+
+    if (meshHitPosition != nullptr)
+        *meshHitPosition = hit->y * A.getDataSize().x + hit->x;
+    return true;
+}
+
+bool dgm::Collision::basic(
+    const dgm::OccupancyMesh& A,
+    const dgm::Rect& B,
+    std::size_t* meshHitPosition)
+{
+    const auto range = getTileRange(
+        sf::FloatRect(B.getPosition() - A.getPosition(), B.getSize()), A);
+    if (!range) return false;
+
+    const auto hit = A.findOccupiedTile(range->first, range->second);
+    if (!hit) return false;
+
+    if (meshHitPosition != nullptr)
+        *meshHitPosition = hit->y * A.getDataSize().x + hit->x;
+    return true;
+}
+
 bool dgm::Collision::basic(const dgm::VisionCone& cone, const dgm::Circle& c)
 {
     auto transposedCirclePos =
@@ -231,6 +539,531 @@ bool dgm::Collision::basic(const dgm::Rect& r, const dgm::VisionCone& cone)
     // clang-format on
 }
 
+[[nodiscard]] static sf::IntRect
+getTileBounds(const dgm::Mesh& mesh, const dgm::Rect& body)
+{
+    return normalizeBoundaries(
+        sf::IntRect(sf::FloatRect(
+            body.getPosition() - mesh.getPosition(), body.getSize())),
+        mesh);
+}
+
+[[nodiscard]] static sf::IntRect
+getTileBounds(const dgm::Mesh& mesh, const dgm::Circle& body)
+{
+    const sf::Vector2f radius(body.getRadius(), body.getRadius());
+    return normalizeBoundaries(
+        sf::IntRect(
+            sf::FloatRect(
+                body.getPosition() - radius - mesh.getPosition(),
+                radius * 2.f)),
+        mesh);
+}
+
+/**
+ *  Rectangle collides with every impassable tile within its bounds, circle
+ *  must also touch the tile
+ */
+[[nodiscard]] static bool touchesTile(const dgm::Rect&, const dgm::Rect&)
+{
+    return true;
+}
+
+[[nodiscard]] static bool
+touchesTile(const dgm::Circle& body, const dgm::Rect& tile)
+{
+    return dgm::Collision::basic(tile, body);
+}
+
+/**
+ *  Penetration depth of a body into a tile and normal pointing out of the
+ *  tile along the axis of the smallest overlap
+ */
+[[nodiscard]] static std::pair<float, sf::Vector2f>
+getPenetration(const dgm::Rect& body, const dgm::Rect& tile)
+{
+    const auto bodyMin = body.getPosition();
+    const auto bodyMax = bodyMin + body.getSize();
+    const auto tileMin = tile.getPosition();
+    const auto tileMax = tileMin + tile.getSize();
+
+    const float overlapX =
+        std::min(bodyMax.x - tileMin.x, tileMax.x - bodyMin.x);
+    const float overlapY =
+        std::min(bodyMax.y - tileMin.y, tileMax.y - bodyMin.y);
+    const auto offset = body.getCenter() - tile.getCenter();
+
+    if (overlapX < overlapY)
+        return { std::max(overlapX, 0.f),
+                 { offset.x < 0.f ? -1.f : 1.f, 0.f } };
+    return { std::max(overlapY, 0.f), { 0.f, offset.y < 0.f ? -1.f : 1.f } };
+}
+
+[[nodiscard]] static std::pair<float, sf::Vector2f>
+getPenetration(const dgm::Circle& body, const dgm::Rect& tile)
+{
+    const auto tileMin = tile.getPosition();
+    const auto tileMax = tileMin + tile.getSize();
+    const auto center = body.getPosition();
+    const auto closest = sf::Vector2f(
+        std::clamp(center.x, tileMin.x, tileMax.x),
+        std::clamp(center.y, tileMin.y, tileMax.y));
+
+    const auto offset = center - closest;
+    const float distance = offset.length();
+    if (distance > 0.f)
+        return { std::max(body.getRadius() - distance, 0.f),
+                 offset / distance };
+
+    // Center is within the tile, push it out through the nearest edge
+    const std::array<std::pair<float, sf::Vector2f>, 4> edges = { {
+        { center.x - tileMin.x, { -1.f, 0.f } },
+        { tileMax.x - center.x, { 1.f, 0.f } },
+        { center.y - tileMin.y, { 0.f, -1.f } },
+        { tileMax.y - center.y, { 0.f, 1.f } },
+    } };
+    const auto nearest = std::min_element(
+        edges.begin(),
+        edges.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    return { body.getRadius() + nearest->first, nearest->second };
+}
+
+/**
+ *  Body moved by a part of the forward vector, tested against the tiles
+ *  the same way as dgm::Collision::basic tests it
+ */
+template<class T>
+struct MeshProbe
+{
+    T body;
+    sf::IntRect bounds = {};
+    bool hit = false;
+    std::size_t hitPosition = 0;
+
+    [[nodiscard]] bool contains(int x, int y) const noexcept
+    {
+        return bounds.position.x <= x && x <= bounds.size.x
+               && bounds.position.y <= y && y <= bounds.size.y;
+    }
+};
+
+template<class T>
+struct MeshContactScan
+{
+    MeshProbe<T> full;
+    MeshProbe<T> alongX;
+    MeshProbe<T> alongY;
+    float penetration = -1.f;
+    sf::Vector2f normal = {};
+};
+
+/**
+ *  Tests the full movement of the body and the movements along each axis,
+ *  which is what dgm::Collision::advanced needs, in a single pass over the
+ *  tiles all of them overlap
+ */
+template<class T>
+[[nodiscard]] static MeshContactScan<T> scanMeshContacts(
+    const dgm::Mesh& mesh, T body, const sf::Vector2f& forward)
+{
+    // Bodies are moved exactly the same way advanced used to move them,
+    // so the rounding of their positions is the same
+    body.move(forward);
+    const T full = body;
+    body.move({ 0.f, -forward.y });
+    const T alongX = body;
+    body.move({ -forward.x, forward.y });
+    auto scan = MeshContactScan<T> {
+        .full = { full }, .alongX = { alongX }, .alongY = { body }
+    };
+
+    const auto probes =
+        std::array<MeshProbe<T>*, 3> { &scan.full, &scan.alongX, &scan.alongY };
+
+    auto from = sf::Vector2i(INT_MAX, INT_MAX);
+    auto to = sf::Vector2i(INT_MIN, INT_MIN);
+    for (auto&& probe : probes)
+    {
+        probe->bounds = getTileBounds(mesh, probe->body);
+        from.x = std::min(from.x, probe->bounds.position.x);
+        from.y = std::min(from.y, probe->bounds.position.y);
+        to.x = std::max(to.x, probe->bounds.size.x);
+        to.y = std::max(to.y, probe->bounds.size.y);
+    }
+    from = { std::max(from.x, 0), std::max(from.y, 0) };
+    to = { std::min(to.x, int(mesh.getDataSize().x) - 1),
+           std::min(to.y, int(mesh.getDataSize().y) - 1) };
+
+    const sf::Vector2f tileSize(mesh.getVoxelSize());
+    const unsigned meshWidth = mesh.getDataSize().x;
+    dgm::Rect tile(sf::Vector2f(0.f, 0.f), tileSize);
+
+    for (int y = from.y; y <= to.y; y++)
+    {
+        for (int x = from.x; x <= to.x; x++)
+        {
+            const std::size_t index = y * meshWidth + x;
+            if (mesh[index] <= 0) continue;
+
+            tile.setPosition(
+                sf::Vector2f(float(x) * tileSize.x, float(y) * tileSize.y)
+                + mesh.getPosition());
+
+            for (auto&& probe : probes)
+            {
+                if (!probe->contains(x, y) || !touchesTile(probe->body, tile))
+                    continue;
+
+                if (!probe->hit) probe->hitPosition = index;
+                probe->hit = true;
+
+                if (probe != &scan.full) continue;
+                const auto [depth, normal] =
+                    getPenetration(scan.full.body, tile);
+                if (depth <= scan.penetration) continue;
+                scan.penetration = depth;
+                scan.normal = normal;
+            }
+        }
+    }
+
+    return scan;
+}
+
+template<class T>
+[[nodiscard]] static std::optional<dgm::Collision::MeshContact>
+resolveMeshContact(
+    const dgm::Mesh& mesh, const T& body, const sf::Vector2f& forward)
+{
+    const auto scan = scanMeshContacts(mesh, body, forward);
+    if (!scan.full.hit) return std::nullopt;
+
+    // Same priorities as in advanced
+    const bool blockedX = scan.alongX.hit;
+    const bool blockedY = !scan.alongX.hit || scan.alongY.hit;
+    return dgm::Collision::MeshContact {
+        .forward = { blockedX ? 0.f : forward.x, blockedY ? 0.f : forward.y },
+        .blockedX = blockedX,
+        .blockedY = blockedY,
+        .penetration = scan.penetration,
+        .normal = scan.normal,
+        .meshHitPosition = scan.full.hitPosition,
+    };
+}
+
+std::optional<dgm::Collision::MeshContact> dgm::Collision::resolve(
+    const dgm::Mesh& mesh,
+    const dgm::Circle& body,
+    const sf::Vector2f& forward)
+{
+    return resolveMeshContact(mesh, body, forward);
+}
+
+std::optional<dgm::Collision::MeshContact> dgm::Collision::resolve(
+    const dgm::Mesh& mesh, const dgm::Rect& body, const sf::Vector2f& forward)
+{
+    return resolveMeshContact(mesh, body, forward);
+}
+
+using SweepResult = std::optional<std::pair<float, sf::Vector2f>>;
+
+/**
+ *  Time at which a point moving by forward enters an open box and normal of
+ *  the side it enters through. Zero time and normal if the point starts
+ *  inside of the box.
+ */
+[[nodiscard]] static SweepResult sweepPoint(
+    const sf::Vector2f& point,
+    const sf::Vector2f& forward,
+    const sf::Vector2f& boxMin,
+    const sf::Vector2f& boxMax)
+{
+    float enter = -std::numeric_limits<float>::infinity();
+    float exit = std::numeric_limits<float>::infinity();
+    sf::Vector2f normal = {};
+
+    auto&& clipAxis =
+        [&](float from, float step, float lo, float hi, sf::Vector2f axis)
+    {
+        if (step == 0.f) return lo < from && from < hi;
+
+        const float toLo = (lo - from) / step;
+        const float toHi = (hi - from) / step;
+        const float axisEnter = std::min(toLo, toHi);
+        if (axisEnter > enter)
+        {
+            enter = axisEnter;
+            normal = step > 0.f ? -axis : axis;
+        }
+        exit = std::min(exit, std::max(toLo, toHi));
+        return true;
+    };
+
+    if (!clipAxis(point.x, forward.x, boxMin.x, boxMax.x, { 1.f, 0.f })
+        || !clipAxis(point.y, forward.y, boxMin.y, boxMax.y, { 0.f, 1.f }))
+        return std::nullopt;
+    if (enter >= exit || exit <= 0.f || enter > 1.f) return std::nullopt;
+    if (enter < 0.f) return std::pair { 0.f, sf::Vector2f() };
+    return std::pair { enter, normal };
+}
+
+/**
+ *  Time at which a point moving by forward reaches a circle and normal of
+ *  the circle at that point. Point must start outside of the circle.
+ */
+[[nodiscard]] static SweepResult sweepPoint(
+    const sf::Vector2f& point,
+    const sf::Vector2f& forward,
+    const sf::Vector2f& center,
+    float radius)
+{
+    const auto offset = point - center;
+    const float b = offset.dot(forward);
+    if (b >= 0.f) return std::nullopt;
+
+    const float a = forward.lengthSquared();
+    const float c = offset.lengthSquared() - radius * radius;
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.f) return std::nullopt;
+
+    const float time = std::max((-b - std::sqrt(discriminant)) / a, 0.f);
+    if (time > 1.f) return std::nullopt;
+
+    const auto normal = offset + forward * time;
+    return std::pair { time, normal / normal.length() };
+}
+
+[[nodiscard]] static SweepResult sweepTile(
+    const dgm::Rect& body,
+    const sf::Vector2f& forward,
+    const sf::Vector2f& tileMin,
+    const sf::Vector2f& tileMax)
+{
+    // Top left corner of the body against the tile grown by the body
+    return sweepPoint(
+        body.getPosition(), forward, tileMin - body.getSize(), tileMax);
+}
+
+[[nodiscard]] static SweepResult sweepTile(
+    const dgm::Circle& body,
+    const sf::Vector2f& forward,
+    const sf::Vector2f& tileMin,
+    const sf::Vector2f& tileMax)
+{
+    const auto center = body.getPosition();
+    const float radius = body.getRadius();
+    const auto closest = sf::Vector2f(
+        std::clamp(center.x, tileMin.x, tileMax.x),
+        std::clamp(center.y, tileMin.y, tileMax.y));
+    if ((center - closest).lengthSquared() < radius * radius)
+        return std::pair { 0.f, sf::Vector2f() };
+
+    // Tile grown by the radius is a union of two boxes and four circles in
+    // its corners, center of the body hits the first of them
+    SweepResult first = std::nullopt;
+    auto&& keepFirst = [&](const SweepResult& hit)
+    {
+        if (hit && (!first || hit->first < first->first)) first = hit;
+    };
+
+    keepFirst(sweepPoint(
+        center,
+        forward,
+        tileMin - sf::Vector2f(radius, 0.f),
+        tileMax + sf::Vector2f(radius, 0.f)));
+    keepFirst(sweepPoint(
+        center,
+        forward,
+        tileMin - sf::Vector2f(0.f, radius),
+        tileMax + sf::Vector2f(0.f, radius)));
+    for (auto&& corner :
+         { tileMin,
+           sf::Vector2f(tileMax.x, tileMin.y),
+           sf::Vector2f(tileMin.x, tileMax.y),
+           tileMax })
+        keepFirst(sweepPoint(center, forward, corner, radius));
+
+    return first;
+}
+
+[[nodiscard]] static std::pair<sf::Vector2f, sf::Vector2f>
+getBoundingBox(const dgm::Rect& body)
+{
+    return { body.getPosition(), body.getPosition() + body.getSize() };
+}
+
+[[nodiscard]] static std::pair<sf::Vector2f, sf::Vector2f>
+getBoundingBox(const dgm::Circle& body)
+{
+    const sf::Vector2f radius(body.getRadius(), body.getRadius());
+    return { body.getPosition() - radius, body.getPosition() + radius };
+}
+
+/**
+ *  Next column or row of tiles the bounding box of a moving body enters
+ *  and when
+ */
+struct SweepLine
+{
+    int line;
+    int direction;
+    float time;
+    float timeStep;
+};
+
+/**
+ *  Line is within the mesh or the box still moves towards it
+ */
+[[nodiscard]] static bool
+isWithinReach(const SweepLine& sweepLine, int lineCount) noexcept
+{
+    return sweepLine.direction > 0 ? sweepLine.line < lineCount
+                                   : sweepLine.line >= 0;
+}
+
+/**
+ *  \param lo Lower edge of the bounding box in tiles
+ *  \param hi Upper edge of the bounding box in tiles
+ *  \param step Movement in tiles
+ */
+[[nodiscard]] static SweepLine
+getFirstSweepLine(float lo, float hi, float step, int lineCount)
+{
+    constexpr float NEVER = std::numeric_limits<float>::infinity();
+    if (step == 0.f) return { 0, 0, NEVER, NEVER };
+
+    // Tiles the box overlaps at the start are tested separately
+    SweepLine result = {};
+    if (step > 0.f)
+    {
+        const float front = std::floor(hi) + 1.f;
+        result = { int(front), 1, (front - hi) / step, 1.f / step };
+    }
+    else
+    {
+        const float front = std::floor(lo);
+        result = { int(front) - 1, -1, (front - lo) / step, -1.f / step };
+    }
+
+    if (!isWithinReach(result, lineCount)) result.time = NEVER;
+    return result;
+}
+
+static void advanceSweepLine(SweepLine& sweepLine, int lineCount)
+{
+    sweepLine.line += sweepLine.direction;
+    sweepLine.time = isWithinReach(sweepLine, lineCount)
+                         ? sweepLine.time + sweepLine.timeStep
+                         : std::numeric_limits<float>::infinity();
+}
+
+/**
+ *  Walks the tiles in the order the bounding box of the body enters them,
+ *  the same way a raycaster walks them, only the front of the box is
+ *  a whole column or row of tiles. Every impassable tile is tested against
+ *  the exact shape of the body and the walk stops as soon as no tile
+ *  further away can be hit sooner.
+ */
+template<class T>
+[[nodiscard]] static std::optional<dgm::Collision::SweepHit>
+sweepMesh(const dgm::Mesh& mesh, const T& body, const sf::Vector2f& forward)
+{
+    const auto meshSize = sf::Vector2i(mesh.getDataSize());
+    const auto tileSize = sf::Vector2f(mesh.getVoxelSize());
+    const auto [worldMin, worldMax] = getBoundingBox(body);
+    const auto boxMin =
+        (worldMin - mesh.getPosition()).componentWiseDiv(tileSize);
+    const auto boxMax =
+        (worldMax - mesh.getPosition()).componentWiseDiv(tileSize);
+    const auto step = forward.componentWiseDiv(tileSize);
+
+    std::optional<dgm::Collision::SweepHit> first = std::nullopt;
+    auto&& testTiles = [&](int fromX, int toX, int fromY, int toY)
+    {
+        fromX = std::max(fromX, 0);
+        toX = std::min(toX, meshSize.x - 1);
+        fromY = std::max(fromY, 0);
+        toY = std::min(toY, meshSize.y - 1);
+
+        for (int y = fromY; y <= toY; y++)
+        {
+            for (int x = fromX; x <= toX; x++)
+            {
+                const std::size_t index = y * meshSize.x + x;
+                if (mesh[index] <= 0) continue;
+
+                const auto tileMin =
+                    mesh.getPosition()
+                    + sf::Vector2f(float(x), float(y)).componentWiseMul(
+                        tileSize);
+                const auto hit =
+                    sweepTile(body, forward, tileMin, tileMin + tileSize);
+                if (!hit || (first && first->time <= hit->first)) continue;
+
+                first = dgm::Collision::SweepHit {
+                    .time = hit->first,
+                    .normal = hit->second,
+                    .meshHitPosition = index,
+                };
+            }
+        }
+    };
+
+    // Range of tiles is inclusive on both ends, so tiles the box merely
+    // touches are tested as well, the exact test sorts them out
+    auto&& getTile = [](float coord) { return int(std::floor(coord)); };
+    testTiles(
+        getTile(boxMin.x),
+        getTile(boxMax.x),
+        getTile(boxMin.y),
+        getTile(boxMax.y));
+
+    auto column = getFirstSweepLine(boxMin.x, boxMax.x, step.x, meshSize.x);
+    auto row = getFirstSweepLine(boxMin.y, boxMax.y, step.y, meshSize.y);
+    while (true)
+    {
+        const float time = std::min(column.time, row.time);
+        if (time > 1.f || (first && first->time <= time)) break;
+
+        const auto offset = step * time;
+        if (column.time <= row.time)
+        {
+            testTiles(
+                column.line,
+                column.line,
+                getTile(boxMin.y + offset.y),
+                getTile(boxMax.y + offset.y));
+            advanceSweepLine(column, meshSize.x);
+        }
+        else
+        {
+            testTiles(
+                getTile(boxMin.x + offset.x),
+                getTile(boxMax.x + offset.x),
+                row.line,
+                row.line);
+            advanceSweepLine(row, meshSize.y);
+        }
+    }
+
+    return first;
+}
+
+std::optional<dgm::Collision::SweepHit> dgm::Collision::sweep(
+    const dgm::Mesh& mesh,
+    const dgm::Circle& body,
+    const sf::Vector2f& forward)
+{
+    return sweepMesh(mesh, body, forward);
+}
+
+std::optional<dgm::Collision::SweepHit> dgm::Collision::sweep(
+    const dgm::Mesh& mesh, const dgm::Rect& body, const sf::Vector2f& forward)
+{
+    return sweepMesh(mesh, body, forward);
+}
+
 template<typename T>
 bool dgm::Collision::advanced(
     const dgm::Mesh& mesh,
@@ -238,28 +1071,26 @@ bool dgm::Collision::advanced(
     sf::Vector2f& forward,
     std::size_t* meshHitPosition)
 {
-    auto localForward = forward;
+    const auto scan = scanMeshContacts(mesh, body, forward);
+    if (!scan.full.hit) return false;
 
-    body.move(localForward);
-    if (!dgm::Collision::basic(mesh, body))
-    {
-        return false;
-    }
-
-    body.move({ 0.f, -localForward.y });
-    if (!dgm::Collision::basic(mesh, body, meshHitPosition))
+    // Sliding along X is preferred over sliding along Y
+    if (!scan.alongX.hit)
     {
         forward.y = 0.f;
         return true;
     }
 
-    body.move({ -localForward.x, localForward.y });
-    if (!dgm::Collision::basic(mesh, body, meshHitPosition))
+    if (meshHitPosition != nullptr)
+        *meshHitPosition = scan.alongX.hitPosition;
+    if (!scan.alongY.hit)
     {
         forward.x = 0.f;
         return true;
     }
 
+    if (meshHitPosition != nullptr)
+        *meshHitPosition = scan.alongY.hitPosition;
     forward = sf::Vector2f(0.f, 0.f);
     return true;
 }
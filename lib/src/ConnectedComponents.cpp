@@ -0,0 +1,174 @@
+#include "DGM/classes/ConnectedComponents.hpp"
+#include <algorithm>
+
+using ComponentId = dgm::ConnectedComponents::ComponentId;
+
+/**
+ *  Calls callback with index of every direct neighbor of a tile that lies
+ *  within the mesh
+ */
+template<class Callback>
+static void forEachNeighbor(
+    std::uint32_t index, const sf::Vector2u& size, Callback&& callback)
+{
+    const unsigned x = index % size.x;
+    const unsigned y = index / size.x;
+    if (x > 0) callback(index - 1);
+    if (x + 1 < size.x) callback(index + 1);
+    if (y > 0) callback(index - size.x);
+    if (y + 1 < size.y) callback(index + size.x);
+}
+
+dgm::ConnectedComponents::ConnectedComponents(const dgm::Mesh& mesh)
+{
+    labelAllTiles(mesh);
+}
+
+void dgm::ConnectedComponents::update(
+    const dgm::Mesh& mesh,
+    const sf::Vector2u& topLeft,
+    const sf::Vector2u& bottomRight)
+{
+    // Every update creates a few labels that are never freed, relabel
+    // everything once there are too many of them
+    if (mesh.getDataSize() != dataSize
+        || labelRoots.size() > tileLabels.size())
+    {
+        labelAllTiles(mesh);
+        return;
+    }
+
+    std::vector<std::uint32_t> openedTiles;
+    std::vector<std::uint32_t> floodSeeds;
+    for (unsigned y = topLeft.y; y <= std::min(bottomRight.y, dataSize.y - 1);
+         ++y)
+    {
+        for (unsigned x = topLeft.x;
+             x <= std::min(bottomRight.x, dataSize.x - 1);
+             ++x)
+        {
+            const std::uint32_t index = y * dataSize.x + x;
+            const bool wasWall = tileLabels[index] == NO_COMPONENT;
+            const bool isWall = mesh[{ x, y }] > 0;
+            if (wasWall == isWall) continue;
+
+            if (isWall)
+            {
+                // Placing a wall can split its component. Every part of it
+                // is adjacent to the wall, so it is enough to label the
+                // neighbors of the wall again.
+                tileLabels[index] = NO_COMPONENT;
+                forEachNeighbor(
+                    index,
+                    dataSize,
+                    [&](std::uint32_t neighbor)
+                    { floodSeeds.push_back(neighbor); });
+            }
+            else
+            {
+                openedTiles.push_back(index);
+            }
+        }
+    }
+
+    // Opened tile merges components of all its passable neighbors
+    for (auto&& index : openedTiles)
+        tileLabels[index] = createLabel();
+    for (auto&& index : openedTiles)
+    {
+        forEachNeighbor(
+            index,
+            dataSize,
+            [&](std::uint32_t neighbor)
+            {
+                if (tileLabels[neighbor] == NO_COMPONENT) return;
+                unite(tileLabels[index], tileLabels[neighbor]);
+            });
+    }
+
+    // Labels created from now on mark tiles that were already flooded
+    const ComponentId firstFloodLabel =
+        static_cast<ComponentId>(labelRoots.size());
+    for (auto&& index : floodSeeds)
+    {
+        if (tileLabels[index] == NO_COMPONENT
+            || tileLabels[index] >= firstFloodLabel)
+            continue;
+        flood(index, createLabel());
+    }
+
+    for (ComponentId label = 0; label < labelRoots.size(); ++label)
+        labelRoots[label] = findRoot(label);
+
+    meshVersion = mesh.getVersion();
+}
+
+void dgm::ConnectedComponents::labelAllTiles(const dgm::Mesh& mesh)
+{
+    dataSize = mesh.getDataSize();
+    meshVersion = mesh.getVersion();
+    tileLabels.assign(dataSize.x * dataSize.y, NO_COMPONENT);
+    labelRoots.clear();
+
+    // Labels that are not assigned yet must differ from NO_COMPONENT
+    // and from all labels created by the flood fills
+    constexpr ComponentId UNLABELLED = NO_COMPONENT - 1;
+    for (unsigned y = 0; y < dataSize.y; ++y)
+    {
+        for (unsigned x = 0; x < dataSize.x; ++x)
+        {
+            if (mesh[{ x, y }] <= 0)
+                tileLabels[y * dataSize.x + x] = UNLABELLED;
+        }
+    }
+
+    for (std::uint32_t index = 0; index < tileLabels.size(); ++index)
+    {
+        if (tileLabels[index] == UNLABELLED) flood(index, createLabel());
+    }
+}
+
+ComponentId dgm::ConnectedComponents::createLabel()
+{
+    const auto label = static_cast<ComponentId>(labelRoots.size());
+    labelRoots.push_back(label);
+    return label;
+}
+
+void dgm::ConnectedComponents::flood(std::uint32_t tileIndex, ComponentId label)
+{
+    queue.clear();
+    queue.push_back(tileIndex);
+    tileLabels[tileIndex] = label;
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        forEachNeighbor(
+            queue[head],
+            dataSize,
+            [&](std::uint32_t neighbor)
+            {
+                if (tileLabels[neighbor] == NO_COMPONENT
+                    || tileLabels[neighbor] == label)
+                    return;
+                tileLabels[neighbor] = label;
+                queue.push_back(neighbor);
+            });
+    }
+}
+
+ComponentId
+dgm::ConnectedComponents::findRoot(ComponentId label) const noexcept
+{
+    while (labelRoots[label] != label)
+        label = labelRoots[label];
+    return label;
+}
+
+void dgm::ConnectedComponents::unite(ComponentId a, ComponentId b) noexcept
+{
+    // Smaller label becomes the root, so roots of old components are kept
+    const ComponentId rootA = findRoot(a);
+    const ComponentId rootB = findRoot(b);
+    labelRoots[std::max(rootA, rootB)] = std::min(rootA, rootB);
+}
@@ -0,0 +1,242 @@
+#include "DGM/classes/DistanceField.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <tuple>
+
+static constexpr float NO_FEATURE = std::numeric_limits<float>::infinity();
+
+/**
+ *  Scratch memory for the lower envelope of parabolas
+ */
+struct Envelope
+{
+    std::vector<float> input = {};
+    std::vector<float> output = {};
+    std::vector<unsigned> roots = {};
+    std::vector<float> boundaries = {};
+};
+
+/**
+ *  Computes output[p] = min over q of (spacing * (p - q))^2 + input[q] for
+ *  all samples of envelope.input in linear time, as described in Distance
+ *  Transforms of Sampled Functions by Felzenszwalb and Huttenlocher.
+ *
+ *  Samples with NO_FEATURE are left out of the envelope entirely, so they
+ *  never spoil the intersections. Output is NO_FEATURE everywhere if there
+ *  are only such samples.
+ */
+static void computeLowerEnvelope(Envelope& envelope, float spacing)
+{
+    const auto& f = envelope.input;
+    const unsigned count = static_cast<unsigned>(f.size());
+    envelope.output.resize(count);
+    envelope.roots.resize(count);
+    envelope.boundaries.resize(count + 1);
+
+    auto& v = envelope.roots;
+    auto& z = envelope.boundaries;
+    auto&& coord = [spacing](unsigned q) { return spacing * q; };
+
+    // Index of the rightmost parabola of the envelope
+    int k = -1;
+    for (unsigned q = 0; q < count; ++q)
+    {
+        if (f[q] == NO_FEATURE) continue;
+
+        const float fq = f[q] + coord(q) * coord(q);
+        float s = -NO_FEATURE;
+        while (k >= 0)
+        {
+            const unsigned r = v[k];
+            s = (fq - (f[r] + coord(r) * coord(r)))
+                / (2.f * (coord(q) - coord(r)));
+            if (s > z[k]) break;
+            --k;
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = k == 0 ? -NO_FEATURE : s;
+        z[k + 1] = NO_FEATURE;
+    }
+
+    if (k < 0)
+    {
+        std::fill(envelope.output.begin(), envelope.output.end(), NO_FEATURE);
+        return;
+    }
+
+    k = 0;
+    for (unsigned p = 0; p < count; ++p)
+    {
+        while (z[k + 1] < coord(p))
+            ++k;
+        const float d = coord(p) - coord(v[k]);
+        envelope.output[p] = d * d + f[v[k]];
+    }
+}
+
+/**
+ *  Calls task(line, envelope) for every line index below count. Lines are
+ *  handed out to the threads in blocks, each thread with its own envelope.
+ */
+template<class Task>
+static void forEachLine(unsigned count, unsigned threadCount, Task&& task)
+{
+    constexpr unsigned BLOCK_SIZE = 16;
+    const unsigned blockCount = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    std::atomic_uint nextBlock = 0;
+    auto&& worker = [&]
+    {
+        Envelope envelope;
+        for (unsigned i = nextBlock++; i < blockCount; i = nextBlock++)
+        {
+            const unsigned end = std::min((i + 1) * BLOCK_SIZE, count);
+            for (unsigned line = i * BLOCK_SIZE; line < end; ++line)
+                task(line, envelope);
+        }
+    };
+
+    threadCount = std::clamp(threadCount, 1u, std::max(1u, blockCount));
+
+    std::vector<std::jthread> workers;
+    for (unsigned i = 1; i < threadCount; ++i)
+        workers.emplace_back(worker);
+    worker();
+}
+
+/**
+ *  Squared distance from the center of every tile to the center of the
+ *  nearest tile whose wall state equals featureIsWall
+ */
+[[nodiscard]] static std::vector<float> computeSquaredDistances(
+    const dgm::Mesh& mesh, bool featureIsWall, unsigned threadCount)
+{
+    const auto size = mesh.getDataSize();
+    const auto spacing = sf::Vector2f(mesh.getVoxelSize());
+    auto result = std::vector<float>(std::size_t { size.x } * size.y);
+
+    // Columns first, then rows of the column results. Each line only
+    // writes its own tiles, so the lines can be processed in any order.
+    forEachLine(
+        size.x,
+        threadCount,
+        [&](unsigned x, Envelope& envelope)
+        {
+            envelope.input.resize(size.y);
+            for (unsigned y = 0; y < size.y; ++y)
+                envelope.input[y] =
+                    (mesh[{ x, y }] > 0) == featureIsWall ? 0.f : NO_FEATURE;
+
+            computeLowerEnvelope(envelope, spacing.y);
+            for (unsigned y = 0; y < size.y; ++y)
+                result[y * size.x + x] = envelope.output[y];
+        });
+
+    forEachLine(
+        size.y,
+        threadCount,
+        [&](unsigned y, Envelope& envelope)
+        {
+            const auto row = result.begin() + y * size.x;
+            envelope.input.assign(row, row + size.x);
+            computeLowerEnvelope(envelope, spacing.x);
+            std::copy(envelope.output.begin(), envelope.output.end(), row);
+        });
+
+    return result;
+}
+
+dgm::DistanceField::DistanceField(const dgm::Mesh& mesh, unsigned threadCount)
+    : dataSize(mesh.getDataSize())
+    , voxelSize(mesh.getVoxelSize())
+    , position(mesh.getPosition())
+    , meshVersion(mesh.getVersion())
+{
+    const auto toWalls = computeSquaredDistances(mesh, true, threadCount);
+    const auto toFreeTiles = computeSquaredDistances(mesh, false, threadCount);
+
+    // Wall boundary lies half a tile away from the center of the nearest
+    // tile across it
+    const float halfTile =
+        static_cast<float>(std::min(voxelSize.x, voxelSize.y)) / 2.f;
+    const float diagonal = std::hypot(
+        static_cast<float>(dataSize.x * voxelSize.x),
+        static_cast<float>(dataSize.y * voxelSize.y));
+
+    distances.resize(toWalls.size());
+    for (std::size_t i = 0; i < distances.size(); ++i)
+    {
+        if (toWalls[i] == NO_FEATURE)
+            distances[i] = diagonal;
+        else if (toFreeTiles[i] == NO_FEATURE)
+            distances[i] = -diagonal;
+        else if (toWalls[i] > 0.f)
+            distances[i] = std::sqrt(toWalls[i]) - halfTile;
+        else
+            distances[i] = halfTile - std::sqrt(toFreeTiles[i]);
+    }
+}
+
+float dgm::DistanceField::sample(const sf::Vector2f& point) const noexcept
+{
+    const auto cell = getCell(point);
+    auto&& at = [&](unsigned x, unsigned y)
+    { return distances[y * dataSize.x + x]; };
+
+    const float top = std::lerp(
+        at(cell.topLeft.x, cell.topLeft.y),
+        at(cell.bottomRight.x, cell.topLeft.y),
+        cell.weight.x);
+    const float bottom = std::lerp(
+        at(cell.topLeft.x, cell.bottomRight.y),
+        at(cell.bottomRight.x, cell.bottomRight.y),
+        cell.weight.x);
+    return std::lerp(top, bottom, cell.weight.y);
+}
+
+sf::Vector2f
+dgm::DistanceField::getGradient(const sf::Vector2f& point) const noexcept
+{
+    // Central differences over a whole tile are symmetric around tile
+    // centers, unlike the derivatives of a single interpolation cell
+    const sf::Vector2f step = sf::Vector2f(voxelSize) / 2.f;
+    return {
+        (sample({ point.x + step.x, point.y })
+         - sample({ point.x - step.x, point.y }))
+            / voxelSize.x,
+        (sample({ point.x, point.y + step.y })
+         - sample({ point.x, point.y - step.y }))
+            / voxelSize.y,
+    };
+}
+
+dgm::DistanceField::Cell
+dgm::DistanceField::getCell(const sf::Vector2f& point) const noexcept
+{
+    auto&& getAxis =
+        [](float coord, float offset, unsigned tileSize, unsigned tileCount)
+    {
+        // Coordinate in tiles relative to the center of the first tile
+        const float tile = std::clamp(
+            (coord - offset) / tileSize - 0.5f,
+            0.f,
+            static_cast<float>(tileCount - 1));
+        const unsigned first = std::min(
+            static_cast<unsigned>(tile), std::max(tileCount, 2u) - 2u);
+        const unsigned second = std::min(first + 1, tileCount - 1);
+        return std::tuple { first, second, tile - first };
+    };
+
+    const auto [left, right, weightX] =
+        getAxis(point.x, position.x, voxelSize.x, dataSize.x);
+    const auto [top, bottom, weightY] =
+        getAxis(point.y, position.y, voxelSize.y, dataSize.y);
+    return Cell { .topLeft = { left, top },
+                  .bottomRight = { right, bottom },
+                  .weight = { weightX, weightY } };
+}
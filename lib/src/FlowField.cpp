@@ -0,0 +1,343 @@
+#include "DGM/classes/FlowField.hpp"
+#include <TileGrid.hpp>
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <thread>
+
+using dgm::priv::TileGrid;
+
+static_assert(dgm::FlowField::STRAIGHT_COST == TileGrid::STRAIGHT_COST);
+static_assert(dgm::FlowField::DIAGONAL_COST == TileGrid::DIAGONAL_COST);
+
+/**
+ *  Wavefronts smaller than this are not worth distributing among threads
+ */
+constexpr std::size_t PARALLEL_THRESHOLD = 1024;
+
+/**
+ *  Calls job(begin, end) for disjoint ranges covering [0, size), possibly
+ *  from multiple threads
+ */
+template<class Job>
+static void parallelFor(std::size_t size, unsigned threadCount, Job&& job)
+{
+    if (threadCount <= 1 || size < PARALLEL_THRESHOLD)
+    {
+        job(std::size_t { 0 }, size);
+        return;
+    }
+
+    std::vector<std::jthread> workers;
+    for (unsigned i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(
+            [&, i]
+            { job(size * i / threadCount, size * (i + 1) / threadCount); });
+    }
+    job(std::size_t { 0 }, size / threadCount);
+}
+
+void dgm::FlowField::compute(
+    const dgm::Mesh& mesh,
+    std::span<const sf::Vector2u> goals,
+    Connectivity _connectivity,
+    unsigned threadCount)
+{
+    dataSize = mesh.getDataSize();
+    connectivity = _connectivity;
+
+    const std::size_t size = std::size_t { dataSize.x } * dataSize.y;
+    distances.assign(size, UNREACHABLE);
+    directions.assign(size, NO_DIRECTION);
+
+    addGoals(mesh, goals, threadCount);
+}
+
+void dgm::FlowField::addGoals(
+    const dgm::Mesh& mesh,
+    std::span<const sf::Vector2u> goals,
+    unsigned threadCount)
+{
+    assert(mesh.getDataSize() == dataSize);
+
+    std::vector<IndexType> seeds;
+    for (auto&& goal : goals)
+    {
+        if (goal.x >= dataSize.x || goal.y >= dataSize.y || mesh[goal] > 0)
+            continue;
+
+        const IndexType index = toIndex(goal);
+        if (distances[index] == 0) continue;
+
+        distances[index] = 0;
+        seeds.push_back(index);
+    }
+
+    propagate(mesh, std::move(seeds), threadCount);
+}
+
+void dgm::FlowField::removeGoals(
+    const dgm::Mesh& mesh,
+    std::span<const sf::Vector2u> goals,
+    unsigned threadCount)
+{
+    assert(mesh.getDataSize() == dataSize);
+
+    const auto grid = TileGrid(mesh, connectivity);
+    const std::size_t directionCount =
+        connectivity == Connectivity::EightWay ? 8 : 4;
+
+    // Directions form a forest rooted in the goals, every tile of a tree
+    // rooted in a removed goal has to find a new way
+    std::vector<IndexType> orphans;
+    for (auto&& goal : goals)
+    {
+        if (goal.x >= dataSize.x || goal.y >= dataSize.y) continue;
+
+        const IndexType index = toIndex(goal);
+        if (distances[index] != 0) continue;
+
+        distances[index] = UNREACHABLE;
+        orphans.push_back(index);
+    }
+
+    for (std::size_t i = 0; i < orphans.size(); ++i)
+    {
+        const auto point =
+            sf::Vector2i(orphans[i] % dataSize.x, orphans[i] / dataSize.x);
+        for (std::size_t d = 0; d < directionCount; ++d)
+        {
+            if (!grid.canStep(point, DIRECTIONS[d])) continue;
+
+            // Steps are symmetric, so the child points back at this tile
+            const IndexType child =
+                toIndex(sf::Vector2u(point + DIRECTIONS[d]));
+            if (directions[child] == NO_DIRECTION
+                || DIRECTIONS[directions[child]] != -DIRECTIONS[d])
+                continue;
+
+            distances[child] = UNREACHABLE;
+            directions[child] = NO_DIRECTION;
+            orphans.push_back(child);
+        }
+    }
+
+    // Tiles bordering the orphans keep their distances, wavefront
+    // restarts from them
+    std::vector<IndexType> seeds;
+    for (auto&& index : orphans)
+    {
+        const auto point = sf::Vector2i(index % dataSize.x, index / dataSize.x);
+        for (std::size_t d = 0; d < directionCount; ++d)
+        {
+            if (!grid.canStep(point, DIRECTIONS[d])) continue;
+
+            const IndexType neighbor =
+                toIndex(sf::Vector2u(point + DIRECTIONS[d]));
+            if (distances[neighbor] != UNREACHABLE) seeds.push_back(neighbor);
+        }
+    }
+    std::sort(seeds.begin(), seeds.end());
+    seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+    propagate(mesh, std::move(seeds), threadCount);
+}
+
+void dgm::FlowField::propagate(
+    const dgm::Mesh& mesh, std::vector<IndexType> seeds, unsigned threadCount)
+{
+    struct Relaxation
+    {
+        IndexType index;
+        unsigned distance;
+    };
+
+    const auto grid = TileGrid(mesh, connectivity);
+    const std::size_t directionCount =
+        connectivity == Connectivity::EightWay ? 8 : 4;
+    threadCount = std::max(threadCount, 1u);
+
+    // Dial's algorithm: since every step costs at most DIAGONAL_COST,
+    // all tentative distances fit into a circular array of buckets
+    constexpr std::size_t BUCKET_COUNT = DIAGONAL_COST + 1;
+    auto buckets = std::array<std::vector<IndexType>, BUCKET_COUNT> {};
+    std::size_t pendingCount = 0;
+
+    // Seeds can be further apart than the buckets reach, so each of them
+    // joins the wavefront once it gets to its distance
+    std::sort(
+        seeds.begin(),
+        seeds.end(),
+        [&](IndexType a, IndexType b) { return distances[a] < distances[b]; });
+    std::size_t nextSeed = 0;
+
+    std::vector<IndexType> frontier;
+    std::vector<IndexType> settled;
+    std::vector<std::vector<Relaxation>> relaxations(threadCount);
+    unsigned currentDistance = 0;
+    unsigned activeThreadCount = 1;
+
+    // Tiles of the frontier have the same distance, so they cannot improve
+    // each other and can be expanded in any order or in parallel. Lowering
+    // distance of a neighbor is an atomic operation, because two tiles of
+    // the frontier can share it.
+    auto expandFrontierChunk = [&](unsigned threadIndex)
+    {
+        const std::size_t begin =
+            frontier.size() * threadIndex / activeThreadCount;
+        const std::size_t end =
+            frontier.size() * (threadIndex + 1) / activeThreadCount;
+        auto& output = relaxations[threadIndex];
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const auto point = sf::Vector2i(
+                frontier[i] % dataSize.x, frontier[i] / dataSize.x);
+
+            for (std::size_t d = 0; d < directionCount; ++d)
+            {
+                if (!grid.canStep(point, DIRECTIONS[d])) continue;
+
+                const IndexType neighbor =
+                    toIndex(sf::Vector2u(point + DIRECTIONS[d]));
+                const unsigned distance =
+                    currentDistance + TileGrid::getStepCost(DIRECTIONS[d]);
+
+                auto ref = std::atomic_ref(distances[neighbor]);
+                unsigned previous = ref.load(std::memory_order_relaxed);
+                while (distance < previous)
+                {
+                    if (ref.compare_exchange_weak(
+                            previous, distance, std::memory_order_relaxed))
+                    {
+                        output.push_back({ neighbor, distance });
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    // Workers sleep on the barrier until the main thread gets to a frontier
+    // large enough to be split
+    auto barrier = std::barrier(static_cast<std::ptrdiff_t>(threadCount));
+    bool finished = false;
+    std::vector<std::jthread> workers;
+    for (unsigned i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(
+            [&, i]
+            {
+                while (true)
+                {
+                    barrier.arrive_and_wait();
+                    if (finished) return;
+                    expandFrontierChunk(i);
+                    barrier.arrive_and_wait();
+                }
+            });
+    }
+
+    for (unsigned distance = 0; pendingCount > 0 || nextSeed < seeds.size();
+         ++distance)
+    {
+        // Nothing can be reached before the next seed
+        if (pendingCount == 0)
+            distance = std::max(distance, distances[seeds[nextSeed]]);
+
+        // Seeds reached by the wavefront in the meantime end up stale
+        for (; nextSeed < seeds.size()
+               && distances[seeds[nextSeed]] <= distance;
+             ++nextSeed)
+        {
+            buckets[distance % BUCKET_COUNT].push_back(seeds[nextSeed]);
+            ++pendingCount;
+        }
+
+        auto& bucket = buckets[distance % BUCKET_COUNT];
+        if (bucket.empty()) continue;
+
+        // Tiles that got even closer since they were bucketed are stale
+        pendingCount -= bucket.size();
+        frontier.clear();
+        for (auto&& index : bucket)
+        {
+            if (distances[index] == distance) frontier.push_back(index);
+        }
+        bucket.clear();
+        settled.insert(settled.end(), frontier.begin(), frontier.end());
+        currentDistance = distance;
+
+        if (threadCount > 1 && frontier.size() >= PARALLEL_THRESHOLD)
+        {
+            activeThreadCount = threadCount;
+            barrier.arrive_and_wait();
+            expandFrontierChunk(0);
+            barrier.arrive_and_wait();
+        }
+        else
+        {
+            activeThreadCount = 1;
+            expandFrontierChunk(0);
+        }
+
+        for (auto&& output : relaxations)
+        {
+            for (auto&& [index, newDistance] : output)
+                buckets[newDistance % BUCKET_COUNT].push_back(index);
+            pendingCount += output.size();
+            output.clear();
+        }
+    }
+
+    finished = true;
+    if (threadCount > 1) barrier.arrive_and_wait();
+
+    updateDirections(mesh, settled, threadCount);
+}
+
+void dgm::FlowField::updateDirections(
+    const dgm::Mesh& mesh,
+    std::span<const IndexType> changedTiles,
+    unsigned threadCount)
+{
+    const auto grid = TileGrid(mesh, connectivity);
+    const std::size_t directionCount =
+        connectivity == Connectivity::EightWay ? 8 : 4;
+
+    parallelFor(
+        changedTiles.size(),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const IndexType index = changedTiles[i];
+                const auto point =
+                    sf::Vector2i(index % dataSize.x, index / dataSize.x);
+
+                // First neighbor on some shortest path wins, goals and
+                // unreachable tiles have none
+                std::uint8_t bestDirection = NO_DIRECTION;
+                for (std::size_t d = 0; d < directionCount; ++d)
+                {
+                    if (!grid.canStep(point, DIRECTIONS[d])) continue;
+
+                    const unsigned neighborDistance =
+                        distances[toIndex(sf::Vector2u(point + DIRECTIONS[d]))];
+                    if (neighborDistance == UNREACHABLE) continue;
+
+                    if (neighborDistance + TileGrid::getStepCost(DIRECTIONS[d])
+                        == distances[index])
+                    {
+                        bestDirection = static_cast<std::uint8_t>(d);
+                        break;
+                    }
+                }
+
+                directions[index] = bestDirection;
+            }
+        });
+}
@@ -0,0 +1,429 @@
+#include "DGM/classes/HierarchicalNavMesh.hpp"
+#include "DGM/classes/Error.hpp"
+#include <AstarSearch.hpp>
+#include <TileGrid.hpp>
+#include <algorithm>
+#include <cassert>
+
+using IndexType = dgm::PathfindingContext::IndexType;
+using dgm::priv::TileGrid;
+
+/**
+ *  Entrances at least this wide get two transitions, one at each end,
+ *  narrower ones get a single transition in the middle
+ */
+constexpr unsigned SPLIT_ENTRANCE_WIDTH = 6;
+
+[[nodiscard]] constexpr static unsigned
+getManhattanDistance(const sf::Vector2u& a, const sf::Vector2u& b) noexcept
+{
+    return (a.x < b.x ? b.x - a.x : a.x - b.x)
+           + (a.y < b.y ? b.y - a.y : a.y - b.y);
+}
+
+/**
+ *  Calls callback for every four-way neighbor of point that is passable
+ *  and lies within bounds
+ */
+template<class Bounds, class Callback>
+static void forEachNeighbor(
+    const TileGrid& grid,
+    const Bounds& bounds,
+    const sf::Vector2u& point,
+    Callback&& callback)
+{
+    for (auto&& direction : TileGrid::STRAIGHT_DIRECTIONS)
+    {
+        if (!grid.canStep(sf::Vector2i(point), direction)) continue;
+
+        const auto neighbor = sf::Vector2u(sf::Vector2i(point) + direction);
+        if (bounds.contains(neighbor)) callback(neighbor);
+    }
+}
+
+dgm::HierarchicalNavMesh::HierarchicalNavMesh(
+    dgm::Mesh _mesh, unsigned clusterSize)
+    : mesh(std::move(_mesh))
+    , clusterSize(clusterSize)
+    , clusterCount(
+          (mesh.getDataSize().x + clusterSize - 1) / std::max(clusterSize, 1u),
+          (mesh.getDataSize().y + clusterSize - 1) / std::max(clusterSize, 1u))
+{
+    if (clusterSize < 2)
+        throw dgm::Exception(
+            "Cluster size of HierarchicalNavMesh must be at least 2");
+
+    clusterNodes.resize(std::size_t { clusterCount.x } * clusterCount.y);
+
+    discoverEntrances();
+    connectClusterNodes();
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::computeAbstractPath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    PathfindingContext& context) const
+{
+    if (!isWalkable(from) || !isWalkable(to))
+        return std::nullopt;
+    else if (from == to)
+        return dgm::Path<TileNavpoint>({}, false);
+
+    // Start and destination are connected to the nodes of their clusters
+    // only for this query, so the graph itself is never modified
+    auto startConnections =
+        connectWithinCluster(from, clusterNodes[getClusterIndex(from)]);
+    if (getClusterIndex(from) == getClusterIndex(to))
+    {
+        const auto directConnection = connectWithinCluster(from, { to });
+        startConnections.insert(
+            startConnections.end(),
+            directConnection.begin(),
+            directConnection.end());
+    }
+
+    const auto connectionsToDestination =
+        connectWithinCluster(to, clusterNodes[getClusterIndex(to)]);
+
+    auto expandNode = [&](PathfindingContext& ctx, IndexType index)
+    {
+        const sf::Vector2u point = ctx.toCoord(index);
+        const unsigned gcost = ctx.getGcost(index);
+
+        auto openConnection = [&](const sf::Vector2u& destination,
+                                  unsigned distance)
+        {
+            const IndexType destinationIndex = ctx.toIndex(destination);
+            if (ctx.isClosed(destinationIndex)) return;
+
+            ctx.openNode(
+                destinationIndex,
+                gcost + distance,
+                getManhattanDistance(destination, to),
+                index);
+        };
+
+        if (point == from)
+        {
+            for (auto&& connection : startConnections)
+                openConnection(connection.destination, connection.distance);
+        }
+
+        if (auto itr = nodeConnections.find(point);
+            itr != nodeConnections.end())
+        {
+            for (auto&& connection : itr->second)
+                openConnection(connection.destination, connection.distance);
+        }
+
+        // Connections to destination are symmetrical to the ones from it
+        for (auto&& connection : connectionsToDestination)
+        {
+            if (connection.destination == point)
+                openConnection(to, connection.distance);
+        }
+    };
+
+    if (!dgm::priv::astarSearch(
+            context,
+            from,
+            to,
+            mesh.getDataSize(),
+            getManhattanDistance(from, to),
+            expandNode))
+        return std::nullopt;
+
+    std::vector<TileNavpoint> points;
+    for (auto&& point : dgm::priv::reconstructPath(context, from, to))
+        points.push_back(TileNavpoint(point, 0u));
+
+    return dgm::Path(std::move(points), false);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::computeAbstractPath(
+    const sf::Vector2u& from, const sf::Vector2u& to) const
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computeAbstractPath(from, to, context);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::refinePathSegment(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    PathfindingContext& context) const
+{
+    if (!isWalkable(from) || !isWalkable(to))
+        return std::nullopt;
+    else if (from == to)
+        return dgm::Path<TileNavpoint>({}, false);
+
+    const auto fromBounds = getClusterBounds(from);
+    const auto toBounds = getClusterBounds(to);
+    const auto bounds = TileBounds {
+        .topLeft = { std::min(fromBounds.topLeft.x, toBounds.topLeft.x),
+                     std::min(fromBounds.topLeft.y, toBounds.topLeft.y) },
+        .bottomRight = { std::max(
+                             fromBounds.bottomRight.x, toBounds.bottomRight.x),
+                         std::max(
+                             fromBounds.bottomRight.y,
+                             toBounds.bottomRight.y) },
+    };
+    const auto grid = TileGrid(mesh, TileNavMesh::Connectivity::FourWay);
+
+    auto expandNode = [&](PathfindingContext& ctx, IndexType index)
+    {
+        const unsigned gcost = ctx.getGcost(index) + 1;
+
+        forEachNeighbor(
+            grid,
+            bounds,
+            ctx.toCoord(index),
+            [&](const sf::Vector2u& neighbor)
+            {
+                const IndexType neighborIndex = ctx.toIndex(neighbor);
+                if (ctx.isClosed(neighborIndex)) return;
+
+                ctx.openNode(
+                    neighborIndex,
+                    gcost,
+                    getManhattanDistance(neighbor, to),
+                    index);
+            });
+    };
+
+    if (!dgm::priv::astarSearch(
+            context,
+            from,
+            to,
+            mesh.getDataSize(),
+            getManhattanDistance(from, to),
+            expandNode))
+        return std::nullopt;
+
+    std::vector<TileNavpoint> points;
+    for (auto&& point : dgm::priv::reconstructPath(context, from, to))
+        points.push_back(TileNavpoint(point, 0u));
+
+    return dgm::Path(std::move(points), false);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    PathfindingContext& context) const
+{
+    auto waypoints = computeAbstractPath(from, to, context);
+    if (!waypoints) return std::nullopt;
+
+    std::vector<TileNavpoint> points;
+    sf::Vector2u segmentStart = from;
+    while (!waypoints->isTraversed())
+    {
+        const sf::Vector2u segmentEnd = waypoints->getCurrentPoint().coord;
+        auto segment = refinePathSegment(segmentStart, segmentEnd, context);
+
+        // Every segment was found by the abstract search
+        assert(segment.has_value());
+        while (!segment->isTraversed())
+        {
+            points.push_back(segment->getCurrentPoint());
+            segment->advance();
+        }
+
+        segmentStart = segmentEnd;
+        waypoints->advance();
+    }
+
+    return dgm::Path(std::move(points), false);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::HierarchicalNavMesh::computePath(
+    const sf::Vector2u& from, const sf::Vector2u& to) const
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computePath(from, to, context);
+}
+
+void dgm::HierarchicalNavMesh::discoverEntrances()
+{
+    const sf::Vector2u size = mesh.getDataSize();
+
+    /**
+     *  Scans the border between two clusters tile by tile. Points a and b
+     *  are the first pair of facing tiles, step moves along the border.
+     */
+    auto scanBorder = [&](sf::Vector2u a,
+                          sf::Vector2u b,
+                          const sf::Vector2u& step,
+                          unsigned length)
+    {
+        unsigned entranceWidth = 0;
+        for (unsigned i = 0; i <= length; ++i)
+        {
+            if (i < length && isWalkable(a) && isWalkable(b))
+            {
+                ++entranceWidth;
+            }
+            else if (entranceWidth > 0)
+            {
+                auto getFacingTiles = [&](unsigned offset)
+                {
+                    return std::pair { a - step * (entranceWidth - offset),
+                                       b - step * (entranceWidth - offset) };
+                };
+
+                if (entranceWidth < SPLIT_ENTRANCE_WIDTH)
+                {
+                    const auto [x, y] = getFacingTiles(entranceWidth / 2);
+                    connectEntrance(x, y);
+                }
+                else
+                {
+                    const auto [x1, y1] = getFacingTiles(0);
+                    connectEntrance(x1, y1);
+                    const auto [x2, y2] = getFacingTiles(entranceWidth - 1);
+                    connectEntrance(x2, y2);
+                }
+
+                entranceWidth = 0;
+            }
+
+            a += step;
+            b += step;
+        }
+    };
+
+    for (unsigned cy = 0; cy < clusterCount.y; ++cy)
+    {
+        for (unsigned cx = 0; cx < clusterCount.x; ++cx)
+        {
+            const auto topLeft = sf::Vector2u(cx, cy) * clusterSize;
+            const auto bounds = getClusterBounds(topLeft);
+            const auto clusterDimensions = bounds.bottomRight - bounds.topLeft;
+
+            if (bounds.bottomRight.x < size.x)
+            {
+                const unsigned x = bounds.bottomRight.x - 1;
+                scanBorder(
+                    { x, topLeft.y },
+                    { x + 1, topLeft.y },
+                    { 0u, 1u },
+                    clusterDimensions.y);
+            }
+
+            if (bounds.bottomRight.y < size.y)
+            {
+                const unsigned y = bounds.bottomRight.y - 1;
+                scanBorder(
+                    { topLeft.x, y },
+                    { topLeft.x, y + 1 },
+                    { 1u, 0u },
+                    clusterDimensions.x);
+            }
+        }
+    }
+}
+
+void dgm::HierarchicalNavMesh::connectClusterNodes()
+{
+    for (auto&& nodes : clusterNodes)
+    {
+        for (auto&& node : nodes)
+        {
+            auto& connections = nodeConnections[node];
+            for (auto&& connection : connectWithinCluster(node, nodes))
+            {
+                if (connection.destination == node) continue;
+                connections.push_back(connection);
+            }
+        }
+    }
+}
+
+void dgm::HierarchicalNavMesh::registerNode(const sf::Vector2u& point)
+{
+    if (nodeConnections.contains(point)) return;
+
+    nodeConnections[point] = {};
+    clusterNodes[getClusterIndex(point)].push_back(point);
+}
+
+void dgm::HierarchicalNavMesh::connectEntrance(
+    const sf::Vector2u& a, const sf::Vector2u& b)
+{
+    registerNode(a);
+    registerNode(b);
+    nodeConnections[a].push_back(Connection { b, 1u });
+    nodeConnections[b].push_back(Connection { a, 1u });
+}
+
+std::vector<dgm::HierarchicalNavMesh::Connection>
+dgm::HierarchicalNavMesh::connectWithinCluster(
+    const sf::Vector2u& origin, const std::vector<sf::Vector2u>& targets) const
+{
+    constexpr unsigned UNREACHABLE = ~0u;
+
+    const auto bounds = getClusterBounds(origin);
+    const auto dimensions = bounds.bottomRight - bounds.topLeft;
+    const auto grid = TileGrid(mesh, TileNavMesh::Connectivity::FourWay);
+
+    auto toLocalIndex = [&](const sf::Vector2u& point)
+    {
+        return (point.y - bounds.topLeft.y) * dimensions.x
+               + (point.x - bounds.topLeft.x);
+    };
+
+    // All steps cost the same, so plain breadth-first search suffices
+    auto distances =
+        std::vector<unsigned>(dimensions.x * dimensions.y, UNREACHABLE);
+    auto queue = std::vector<sf::Vector2u> { origin };
+    queue.reserve(distances.size());
+    distances[toLocalIndex(origin)] = 0;
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        const sf::Vector2u point = queue[head];
+        const unsigned distance = distances[toLocalIndex(point)] + 1;
+
+        forEachNeighbor(
+            grid,
+            bounds,
+            point,
+            [&](const sf::Vector2u& neighbor)
+            {
+                unsigned& neighborDistance = distances[toLocalIndex(neighbor)];
+                if (neighborDistance != UNREACHABLE) return;
+                neighborDistance = distance;
+                queue.push_back(neighbor);
+            });
+    }
+
+    std::vector<Connection> connections;
+    for (auto&& target : targets)
+    {
+        const unsigned distance = distances[toLocalIndex(target)];
+        if (distance != UNREACHABLE)
+            connections.push_back(Connection { target, distance });
+    }
+    return connections;
+}
+
+dgm::HierarchicalNavMesh::TileBounds
+dgm::HierarchicalNavMesh::getClusterBounds(
+    const sf::Vector2u& point) const noexcept
+{
+    const sf::Vector2u size = mesh.getDataSize();
+    const auto topLeft = sf::Vector2u(
+        point.x / clusterSize * clusterSize,
+        point.y / clusterSize * clusterSize);
+    return TileBounds {
+        .topLeft = topLeft,
+        .bottomRight = { std::min(topLeft.x + clusterSize, size.x),
+                         std::min(topLeft.y + clusterSize, size.y) },
+    };
+}
@@ -1,437 +1,1766 @@
 #include "DGM/classes/NavMesh.hpp"
 #include "DGM/classes/Error.hpp"
+#include "DGM/classes/Raycaster.hpp"
+#include <AstarSearch.hpp>
 #include <JumpPointSearchUtilities.hpp>
+#include <TileGrid.hpp>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <fstream>
 #include <functional>
-#include <map>
-#include <queue>
+#include <thread>
 
-template<class T>
-concept AstarNode =
-    std::is_class<T>::value
-    && std::is_member_function_pointer_v<decltype(&T::isCloserThan)>
-    && std::is_member_object_pointer_v<decltype(&T::point)>
-    && std::is_member_object_pointer_v<decltype(&T::gcost)>;
+namespace custom
+{
+    [[nodiscard]] constexpr unsigned max(unsigned a, unsigned b) noexcept
+    {
+        return a < b ? b : a;
+    }
+
+    [[nodiscard]] constexpr unsigned min(unsigned a, unsigned b) noexcept
+    {
+        return a < b ? a : b;
+    }
+
+    [[nodiscard]] constexpr unsigned
+    getScalarDistance(unsigned a, unsigned b) noexcept
+    {
+        return max(a, b) - min(a, b);
+    }
+} // namespace custom
+
+using IndexType = dgm::PathfindingContext::IndexType;
 
-template<AstarNode NodeType>
-class NodeSet
+using dgm::priv::astarSearch;
+using dgm::priv::reconstructPath;
+using dgm::priv::TileGrid;
+using Connectivity = dgm::TileNavMesh::Connectivity;
+
+static_assert(dgm::TileNavMesh::STRAIGHT_COST == TileGrid::STRAIGHT_COST);
+static_assert(dgm::TileNavMesh::DIAGONAL_COST == TileGrid::DIAGONAL_COST);
+
+[[nodiscard]] static sf::Vector2i toSigned(const sf::Vector2u& point) noexcept
+{
+    return sf::Vector2i(point);
+}
+
+[[nodiscard]] static sf::Vector2u toUnsigned(const sf::Vector2i& point) noexcept
+{
+    return sf::Vector2u(point);
+}
+
+/*
+ * Test whether a tile reached by a straight move has a forced neighbor,
+ * that is a tile that can only be reached optimally through this tile
+ */
+[[nodiscard]] static bool hasForcedNeighbor(
+    const TileGrid& grid,
+    const sf::Vector2i& point,
+    const sf::Vector2i& direction) noexcept
+{
+    const int x = point.x;
+    const int y = point.y;
+    const int dx = direction.x;
+    const int dy = direction.y;
+
+    if (dx != 0)
+        return (grid.isWalkable(x, y - 1) && !grid.isWalkable(x - dx, y - 1))
+               || (grid.isWalkable(x, y + 1)
+                   && !grid.isWalkable(x - dx, y + 1));
+
+    return (grid.isWalkable(x - 1, y) && !grid.isWalkable(x - 1, y - dy))
+           || (grid.isWalkable(x + 1, y) && !grid.isWalkable(x + 1, y - dy));
+}
+
+/*
+ * In eight-way grids, jump only continues straight or diagonally. In four-way
+ * grids, diagonal moves are replaced by vertical jumps which scan
+ * horizontally from every tile they pass.
+ */
+[[nodiscard]] static bool isSweepingDirection(
+    const TileGrid& grid, const sf::Vector2i& direction) noexcept
+{
+    if (grid.getConnectivity() == Connectivity::EightWay)
+        return direction.x != 0 && direction.y != 0;
+    return direction.x == 0;
+}
+
+/*
+ * Straight directions scanned from every tile of a sweeping jump
+ */
+[[nodiscard]] static std::array<sf::Vector2i, 2> getSweepDirections(
+    const TileGrid& grid, const sf::Vector2i& direction) noexcept
+{
+    if (grid.getConnectivity() == Connectivity::EightWay)
+        return { sf::Vector2i(direction.x, 0), sf::Vector2i(0, direction.y) };
+    return { sf::Vector2i(-1, 0), sf::Vector2i(1, 0) };
+}
+
+/*
+ * Move from 'from' in given direction until a jump point, the goal or an
+ * obstacle is encountered. Returns the first two, nothing on obstacle.
+ */
+[[nodiscard]] static std::optional<sf::Vector2i> jump(
+    const TileGrid& grid,
+    const sf::Vector2i& from,
+    const sf::Vector2i& direction,
+    const sf::Vector2i& goal)
+{
+    const bool sweeping = isSweepingDirection(grid, direction);
+
+    for (sf::Vector2i point = from; grid.canStep(point, direction);)
+    {
+        point += direction;
+        if (point == goal) return point;
+
+        if (!sweeping)
+        {
+            if (hasForcedNeighbor(grid, point, direction)) return point;
+            continue;
+        }
+
+        if (direction.x == 0 && hasForcedNeighbor(grid, point, direction))
+            return point;
+
+        for (auto&& sweepDirection : getSweepDirections(grid, direction))
+        {
+            if (jump(grid, point, sweepDirection, goal)) return point;
+        }
+    }
+
+    return std::nullopt;
+}
+
+/*
+ * Same as jump, but uses precomputed jump distances so only the goal has to
+ * be tested explicitly
+ */
+[[nodiscard]] static std::optional<sf::Vector2i> jumpWithTable(
+    const TileGrid& grid,
+    const dgm::TileNavMesh::JumpPointTable& table,
+    const sf::Vector2i& from,
+    const sf::Vector2i& direction,
+    const sf::Vector2i& goal)
 {
-protected:
-    std::map<sf::Vector2u, NodeType, dgm::Utility::less<sf::Vector2u>> nodes;
+    auto getReach = [&](const sf::Vector2i& point, const sf::Vector2i& dir)
+    { return std::abs(table.getJumpDistance(toUnsigned(point), dir)); };
+
+    // Number of steps needed to get to the goal, or zero if goal is not on
+    // the ray
+    auto getStepsToGoal =
+        [&](const sf::Vector2i& point, const sf::Vector2i& dir)
+    {
+        const sf::Vector2i delta = goal - point;
+        if (dir.x == 0 ? delta.x != 0 : delta.y != 0) return 0;
+        const int steps = dir.x == 0 ? delta.y * dir.y : delta.x * dir.x;
+        return steps > 0 ? steps : 0;
+    };
 
-public:
-    void insertNode(const NodeType& node)
+    const int distance = table.getJumpDistance(toUnsigned(from), direction);
+    const int reach = std::abs(distance);
+
+    if (!isSweepingDirection(grid, direction))
+    {
+        const int steps = getStepsToGoal(from, direction);
+        if (steps > 0 && steps <= reach) return goal;
+    }
+    else
     {
-        if (nodes.find(node.point) != nodes.end()
-            && nodes[node.point].gcost < node.gcost)
-            return;
-        nodes[node.point] = node;
+        // Goal can only be found by a sweep from tiles aligned with it
+        std::array<int, 2> candidates = {
+            (goal.y - from.y) * direction.y,
+            direction.x == 0 ? 0 : (goal.x - from.x) * direction.x,
+        };
+        std::sort(candidates.begin(), candidates.end());
+
+        for (auto&& steps : candidates)
+        {
+            if (steps <= 0 || steps > reach) continue;
+
+            const sf::Vector2i point = from + direction * steps;
+            if (point == goal) return point;
+
+            for (auto&& sweepDirection : getSweepDirections(grid, direction))
+            {
+                const int sweepSteps = getStepsToGoal(point, sweepDirection);
+                if (sweepSteps > 0
+                    && sweepSteps <= getReach(point, sweepDirection))
+                    return point;
+            }
+        }
     }
 
-    [[nodiscard]] bool hasElements() const noexcept
+    if (distance > 0) return from + direction * distance;
+    return std::nullopt;
+}
+
+/*
+ * Directions in which it makes sense to continue from a jump point
+ * that was reached by moving in a given direction. Zero direction
+ * means the point is the start of the search.
+ */
+template<class Callback>
+static void forEachPrunedDirection(
+    const TileGrid& grid,
+    const sf::Vector2i& point,
+    const sf::Vector2i& direction,
+    Callback&& callback)
+{
+    auto tryDirection = [&](const sf::Vector2i& dir)
     {
-        return !nodes.empty();
+        if (grid.canStep(point, dir)) callback(dir);
+    };
+
+    const bool eightWay = grid.getConnectivity() == Connectivity::EightWay;
+
+    if (direction == sf::Vector2i())
+    {
+        for (auto&& dir : TileGrid::STRAIGHT_DIRECTIONS)
+            tryDirection(dir);
+        if (eightWay)
+        {
+            for (auto&& dir : TileGrid::DIAGONAL_DIRECTIONS)
+                tryDirection(dir);
+        }
     }
+    else if (direction.x != 0 && direction.y != 0)
+    {
+        tryDirection({ 0, direction.y });
+        tryDirection({ direction.x, 0 });
+        tryDirection(direction);
+    }
+    else
+    {
+        const sf::Vector2i side = { direction.y, direction.x };
+        tryDirection(direction);
+        tryDirection(side);
+        tryDirection(-side);
+        if (eightWay)
+        {
+            tryDirection(direction + side);
+            tryDirection(direction - side);
+        }
+    }
+}
+
+/*
+ * Expands path between jump points into path going through every tile
+ */
+[[nodiscard]] static std::vector<sf::Vector2u> expandJumpPoints(
+    const sf::Vector2u& from, const std::vector<sf::Vector2u>& jumpPoints)
+{
+    std::vector<sf::Vector2u> points;
+    sf::Vector2i current = toSigned(from);
 
-    [[nodiscard]] bool contains(const sf::Vector2u& p) const noexcept
+    for (auto&& jumpPoint : jumpPoints)
     {
-        const auto itr = nodes.find(p);
-        return itr != nodes.end();
+        const sf::Vector2i target = toSigned(jumpPoint);
+        const sf::Vector2i direction = dgm::priv::getDirection(current, target);
+        while (current != target)
+        {
+            current += direction;
+            points.push_back(toUnsigned(current));
+        }
     }
 
-    [[nodiscard]] NodeType popBestNode()
+    return points;
+}
+
+dgm::TileNavMesh::JumpPointTable::JumpPointTable(
+    const dgm::Mesh& mesh, Connectivity connectivity)
+    : dataSize(mesh.getDataSize())
+    , connectivity(connectivity)
+    , distances(std::size_t { dataSize.x } * dataSize.y)
+{
+    const auto grid = TileGrid(mesh, connectivity);
+    const sf::Vector2i size = grid.getSize();
+
+    // Every tile depends on its neighbor in the direction of travel, so
+    // tiles are visited starting from the far end
+    auto forEachTileTowards = [&](const sf::Vector2i& direction, auto&& fn)
     {
-        auto minElem = nodes.begin();
-        for (auto itr = (++nodes.begin()); itr != nodes.end(); itr++)
+        for (int row = 0; row < size.y; ++row)
         {
-            if (itr->second.isCloserThan(minElem->second))
+            const int y = direction.y > 0 ? size.y - row - 1 : row;
+            for (int column = 0; column < size.x; ++column)
             {
-                minElem = itr;
+                const int x = direction.x > 0 ? size.x - column - 1 : column;
+                fn(sf::Vector2i(x, y));
             }
         }
+    };
 
-        const NodeType copy = minElem->second;
-        nodes.erase(minElem);
-        return copy;
+    auto computeDirection = [&](const sf::Vector2i& direction)
+    {
+        const bool sweeping = isSweepingDirection(grid, direction);
+
+        forEachTileTowards(
+            direction,
+            [&](const sf::Vector2i& point)
+            {
+                int& distance = at(toUnsigned(point), direction);
+                if (!grid.canStep(point, direction))
+                {
+                    distance = 0;
+                    return;
+                }
+
+                const sf::Vector2i next = point + direction;
+                bool isJumpPoint =
+                    (!sweeping || direction.x == 0)
+                    && hasForcedNeighbor(grid, next, direction);
+
+                if (sweeping)
+                {
+                    for (auto&& dir : getSweepDirections(grid, direction))
+                        isJumpPoint |= at(toUnsigned(next), dir) > 0;
+                }
+
+                const int nextDistance = at(toUnsigned(next), direction);
+                if (isJumpPoint)
+                    distance = 1;
+                else
+                    distance =
+                        nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+            });
+    };
+
+    // Sweeping directions depend on the straight ones
+    for (auto&& direction : TileGrid::STRAIGHT_DIRECTIONS)
+    {
+        if (!isSweepingDirection(grid, direction)) computeDirection(direction);
     }
 
-    [[nodiscard]] const NodeType& getNode(const sf::Vector2u& point) const
+    for (auto&& direction : TileGrid::STRAIGHT_DIRECTIONS)
     {
-        return nodes.at(point);
+        if (isSweepingDirection(grid, direction)) computeDirection(direction);
     }
-};
 
-namespace custom
+    if (connectivity == Connectivity::EightWay)
+    {
+        for (auto&& direction : TileGrid::DIAGONAL_DIRECTIONS)
+            computeDirection(direction);
+    }
+}
+
+/**
+ *  Opens all successors of a freshly closed node of a tile search, which
+ *  are either its neighbors or, with jump point search, the jump points
+ *  reachable from it
+ */
+static void expandTileNode(
+    dgm::PathfindingContext& context,
+    IndexType index,
+    const TileGrid& grid,
+    const sf::Vector2i& goal,
+    const dgm::TileNavMesh::SearchOptions& options)
 {
-    [[nodiscard]] constexpr unsigned max(unsigned a, unsigned b) noexcept
+    const sf::Vector2i point = toSigned(context.toCoord(index));
+
+    auto openNode = [&](const sf::Vector2i& successor)
     {
-        return a < b ? b : a;
+        const IndexType successorIndex = context.toIndex(toUnsigned(successor));
+        if (context.isClosed(successorIndex)) return;
+
+        context.openNode(
+            successorIndex,
+            context.getGcost(index) + grid.getDistance(point, successor),
+            grid.getDistance(successor, goal),
+            index);
+    };
+
+    if (options.algorithm == dgm::TileNavMesh::SearchAlgorithm::JumpPointSearch)
+    {
+        const sf::Vector2i parent =
+            toSigned(context.toCoord(context.getParent(index)));
+
+        forEachPrunedDirection(
+            grid,
+            point,
+            dgm::priv::getDirection(parent, point),
+            [&](const sf::Vector2i& direction)
+            {
+                const auto jumpPoint =
+                    options.jumpPointTable && options.agentSize <= 1
+                        ? jumpWithTable(
+                              grid,
+                              *options.jumpPointTable,
+                              point,
+                              direction,
+                              goal)
+                        : jump(grid, point, direction, goal);
+                if (jumpPoint) openNode(*jumpPoint);
+            });
+        return;
     }
 
-    [[nodiscard]] constexpr unsigned min(unsigned a, unsigned b) noexcept
+    for (auto&& direction : TileGrid::STRAIGHT_DIRECTIONS)
     {
-        return a < b ? a : b;
+        if (grid.canStep(point, direction)) openNode(point + direction);
     }
 
-    [[nodiscard]] constexpr unsigned
-    getScalarDistance(unsigned a, unsigned b) noexcept
+    if (options.connectivity == Connectivity::FourWay) return;
+
+    for (auto&& direction : TileGrid::DIAGONAL_DIRECTIONS)
     {
-        return max(a, b) - min(a, b);
+        if (grid.canStep(point, direction)) openNode(point + direction);
     }
-} // namespace custom
+}
 
-template<AstarNode NodeType>
-// First parameter is open set, second is coordinate to update from and third
-// parameter is closed set
-using UpdateOpenSetWithCoordCallback = std::function<void(
-    NodeSet<NodeType>&, const sf::Vector2u&, const NodeSet<NodeType>&)>;
+/**
+ *  Builds the resulting path of a tile search that reached its destination
+ */
+[[nodiscard]] static dgm::Path<dgm::TileNavpoint> buildTilePath(
+    const dgm::PathfindingContext& context,
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::TileNavMesh::SearchOptions& options)
+{
+    auto&& coords = reconstructPath(context, from, to);
+    if (options.algorithm
+        == dgm::TileNavMesh::SearchAlgorithm::JumpPointSearch)
+        coords = expandJumpPoints(from, coords);
 
-/*
- * Returns ClosedSet from which path can be reconstructed or returns empty set
- * if no path was found
+    std::vector<dgm::TileNavpoint> points;
+    for (auto&& point : coords)
+        points.push_back(dgm::TileNavpoint(point, 0u));
+
+    return dgm::Path(std::move(points), false);
+}
+
+[[nodiscard]] static bool areSearchOptionsValid(
+    const dgm::Mesh& mesh, const dgm::TileNavMesh::SearchOptions& options)
+{
+    const bool isTableValid =
+        !options.jumpPointTable
+        || (options.jumpPointTable->getDataSize() == mesh.getDataSize()
+            && options.jumpPointTable->getConnectivity()
+                   == options.connectivity);
+    return isTableValid;
+}
+
+/**
+ *  Without an up to date clearance map, large agents would be searched as
+ *  if they occupied a single tile and their paths would cut through gaps
+ *  they can't fit into
  */
-template<AstarNode NodeType>
-static decltype(auto) astarSearch(
-    NodeType startNode,
-    const sf::Vector2u& destinationCoord,
-    UpdateOpenSetWithCoordCallback<NodeType> updateOpenSetWithCoordCallback)
+static void validateClearance(
+    const dgm::Mesh& mesh, const dgm::TileNavMesh::SearchOptions& options)
 {
-    NodeSet<NodeType> openSet, closedSet;
+    if (options.agentSize <= 1) return;
+
+    if (!options.clearance)
+        throw dgm::Exception(
+            "Agents larger than one tile require a clearance map");
+    else if (
+        options.clearance->getDataSize() != mesh.getDataSize()
+        || options.clearance->getMeshVersion() != mesh.getVersion())
+        throw dgm::Exception("Clearance map is not up to date with the mesh");
+}
 
-    closedSet.insertNode(startNode);
-    updateOpenSetWithCoordCallback(openSet, startNode.point, closedSet);
+[[nodiscard]] static TileGrid makeTileGrid(
+    const dgm::Mesh& mesh, const dgm::TileNavMesh::SearchOptions& options)
+{
+    return TileGrid(
+        mesh, options.connectivity, options.clearance, options.agentSize);
+}
+
+/**
+ *  Components that don't match the current state of the mesh might
+ *  separate tiles that were connected by an edit, so they are ignored
+ *  and the search runs in full
+ */
+[[nodiscard]] static bool areComponentsUpToDate(
+    const dgm::ConnectedComponents& components, const dgm::Mesh& mesh)
+{
+    return components.getDataSize() == mesh.getDataSize()
+           && components.getMeshVersion() == mesh.getVersion();
+}
 
-    while (openSet.hasElements())
+/**
+ *  Only tiles within the same component can be connected by a path
+ */
+[[nodiscard]] static bool areDisconnected(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const dgm::TileNavMesh::SearchOptions& options)
+{
+    return options.components
+           && areComponentsUpToDate(*options.components, mesh)
+           && !options.components->areConnected(from, to);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options)
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computePath(from, to, mesh, context, options);
+}
+
+/**
+ *  Runs a tile search between two tiles, returns cost of the path if the
+ *  destination was reached. Unless from == to, the path can then be
+ *  reconstructed from the context.
+ */
+[[nodiscard]] static std::optional<unsigned> searchTilePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    dgm::PathfindingContext& context,
+    const dgm::TileNavMesh::SearchOptions& options)
+{
+    assert(areSearchOptionsValid(mesh, options));
+    validateClearance(mesh, options);
+
+    const auto grid = makeTileGrid(mesh, options);
+    const sf::Vector2i goal = toSigned(to);
+
+    if (!grid.isWalkable(toSigned(from)))
+        return std::nullopt;
+    else if (from == to)
+        return 0u;
+    else if (areDisconnected(from, to, mesh, options))
+        return std::nullopt;
+
+    const bool found = astarSearch(
+        context,
+        from,
+        to,
+        mesh.getDataSize(),
+        grid.getDistance(toSigned(from), goal),
+        [&](dgm::PathfindingContext& ctx, IndexType index)
+        { expandTileNode(ctx, index, grid, goal, options); });
+    if (!found) return std::nullopt;
+
+    return context.getGcost(context.toIndex(to));
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathfindingContext& context,
+    const SearchOptions& options)
+{
+    if (!searchTilePath(from, to, mesh, context, options))
+        return std::nullopt;
+    else if (from == to)
+        return dgm::Path<TileNavpoint>({}, false);
+
+    return buildTilePath(context, from, to, options);
+}
+
+std::optional<unsigned> dgm::TileNavMesh::computeDistance(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathfindingContext& context,
+    const SearchOptions& options)
+{
+    return searchTilePath(from, to, mesh, context, options);
+}
+
+std::optional<unsigned> dgm::TileNavMesh::computeDistance(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options)
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computeDistance(from, to, mesh, context, options);
+}
+
+std::vector<std::optional<unsigned>> dgm::TileNavMesh::computeDistances(
+    const sf::Vector2u& from,
+    std::span<const sf::Vector2u> targets,
+    const dgm::Mesh& mesh,
+    PathfindingContext& context,
+    const SearchOptions& options)
+{
+    assert(areSearchOptionsValid(mesh, options));
+    validateClearance(mesh, options);
+
+    auto distances = std::vector<std::optional<unsigned>>(targets.size());
+    const auto grid = makeTileGrid(mesh, options);
+    if (!grid.isWalkable(toSigned(from))) return distances;
+
+    dgm::priv::beginAstarSearch(context, from, mesh.getDataSize(), 0u);
+
+    // Pending targets are sorted by their tile index, so each closed node
+    // can be matched against them by binary search
+    std::vector<std::pair<IndexType, std::size_t>> pendingTargets;
+    for (std::size_t i = 0; i < targets.size(); ++i)
     {
-        const NodeType node = openSet.popBestNode();
-        closedSet.insertNode(node);
+        if (targets[i] == from)
+            distances[i] = 0u;
+        else if (
+            grid.isWalkable(toSigned(targets[i]))
+            && !areDisconnected(from, targets[i], mesh, options))
+            pendingTargets.emplace_back(context.toIndex(targets[i]), i);
+    }
+    std::sort(pendingTargets.begin(), pendingTargets.end());
 
-        if (node.point == destinationCoord) return closedSet;
+    // Dijkstra, nodes are closed in the order of their distance
+    std::size_t pendingCount = pendingTargets.size();
+    while (pendingCount > 0 && context.hasOpenNodes())
+    {
+        const IndexType index = context.popBestNode();
+        const unsigned gcost = context.getGcost(index);
+
+        for (auto itr = std::lower_bound(
+                 pendingTargets.begin(),
+                 pendingTargets.end(),
+                 std::pair(index, std::size_t { 0 }));
+             itr != pendingTargets.end() && itr->first == index;
+             ++itr)
+        {
+            distances[itr->second] = gcost;
+            --pendingCount;
+        }
+
+        const sf::Vector2i point = toSigned(context.toCoord(index));
+        auto tryStep = [&](const sf::Vector2i& direction)
+        {
+            if (!grid.canStep(point, direction)) return;
+            const IndexType successor =
+                context.toIndex(toUnsigned(point + direction));
+            if (context.isClosed(successor)) return;
+
+            context.openNode(
+                successor,
+                gcost + TileGrid::getStepCost(direction),
+                0u,
+                index);
+        };
+
+        for (auto&& direction : TileGrid::STRAIGHT_DIRECTIONS)
+            tryStep(direction);
+
+        if (options.connectivity == Connectivity::FourWay) continue;
 
-        updateOpenSetWithCoordCallback(openSet, node.point, closedSet);
+        for (auto&& direction : TileGrid::DIAGONAL_DIRECTIONS)
+            tryStep(direction);
     }
 
-    return NodeSet<NodeType>();
+    return distances;
+}
+
+std::vector<std::optional<unsigned>> dgm::TileNavMesh::computeDistances(
+    const sf::Vector2u& from,
+    std::span<const sf::Vector2u> targets,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options)
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computeDistances(from, targets, mesh, context, options);
+}
+
+dgm::TileNavMesh::PathSearch::PathSearch(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    const SearchOptions& options)
+    : from(from)
+    , to(to)
+    , mesh(&mesh)
+    , options(options)
+    , meshVersion(mesh.getVersion())
+{
+    assert(areSearchOptionsValid(mesh, options));
+    validateClearance(mesh, options);
+
+    const auto grid = makeTileGrid(mesh, options);
+    if (!grid.isWalkable(toSigned(from)))
+        status = Status::Unreachable;
+    else if (from == to)
+        status = Status::Found;
+    else if (areDisconnected(from, to, mesh, options))
+        status = Status::Unreachable;
+    else
+        dgm::priv::beginAstarSearch(
+            context,
+            from,
+            mesh.getDataSize(),
+            grid.getDistance(toSigned(from), toSigned(to)));
 }
 
-enum class Backdir
+std::size_t dgm::TileNavMesh::PathSearch::step(std::size_t maxExpansions)
 {
-    Undefined,
-    Up,
-    Left,
-    Down,
-    Right
+    if (isFinished()) return 0;
+
+    assert(mesh->getVersion() == meshVersion && "Mesh changed during search");
+
+    const auto grid = makeTileGrid(*mesh, options);
+    const sf::Vector2i goal = toSigned(to);
+
+    std::size_t budget = maxExpansions;
+    const bool found = dgm::priv::continueAstarSearch(
+        context,
+        to,
+        budget,
+        [&](PathfindingContext& ctx, IndexType index)
+        { expandTileNode(ctx, index, grid, goal, options); });
+
+    if (found)
+        status = Status::Found;
+    else if (!context.hasOpenNodes())
+        status = Status::Unreachable;
+
+    const std::size_t expandedCount = maxExpansions - budget;
+    expandedNodeCount += expandedCount;
+    return expandedCount;
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::TileNavMesh::PathSearch::getPath() const
+{
+    if (status != Status::Found) return std::nullopt;
+    if (from == to) return dgm::Path<TileNavpoint>({}, false);
+    return buildTilePath(context, from, to, options);
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    const dgm::Mesh& mesh,
+    PathCache<TileNavpoint>& cache,
+    const SearchOptions& options)
+{
+    // Path of a wrongly sized agent must not end up cached under the key
+    // of the requested size
+    validateClearance(mesh, options);
+
+    // Jump point table doesn't change the result, only its speed
+    const auto variant = std::max(options.agentSize, 1u) << 2
+                         | static_cast<std::uint32_t>(options.algorithm) << 1
+                         | static_cast<std::uint32_t>(options.connectivity);
+
+    return cache.getOrCompute(
+        from,
+        to,
+        variant,
+        mesh.getVersion(),
+        [&](PathfindingContext& context)
+        { return computePath(from, to, mesh, context, options); });
+}
+
+dgm::Path<dgm::TileNavpoint> dgm::TileNavMesh::smoothPath(
+    const sf::Vector2u& from,
+    const dgm::Path<TileNavpoint>& path,
+    const dgm::Mesh& mesh)
+{
+    if (path.isLooping()) return path.clone();
+
+    const auto voxelSize = sf::Vector2f(mesh.getVoxelSize());
+    auto toTileCenter = [&](const sf::Vector2u& tile)
+    {
+        return (sf::Vector2f(tile) + sf::Vector2f(0.5f, 0.5f))
+            .componentWiseMul(voxelSize);
+    };
+
+    const auto points =
+        path.isTraversed()
+            ? std::span<const TileNavpoint>()
+            : path.getPoints().subspan(path.getCursor().getIndex());
+
+    // Greedy string pulling: each kept waypoint is visible from the
+    // previous one, because it was the target of the last successful check
+    std::vector<TileNavpoint> smoothedPoints;
+    auto anchor = toTileCenter(from);
+    for (std::size_t i = 0; i + 1 < points.size(); ++i)
+    {
+        if (dgm::Raycaster::hasDirectVisibility(
+                anchor, toTileCenter(points[i + 1].coord), mesh))
+            continue;
+
+        smoothedPoints.push_back(points[i]);
+        anchor = toTileCenter(points[i].coord);
+    }
+
+    if (!points.empty()) smoothedPoints.push_back(points.back());
+
+    return dgm::Path<TileNavpoint>(std::move(smoothedPoints), false);
+}
+
+// ========= WORLD NAVMESH ===========
+
+/**
+ *  Heuristic of the world navmesh is an euclidean distance in tiles
+ */
+[[nodiscard]] static unsigned
+getWorldHcost(const sf::Vector2u& point, const sf::Vector2u& end)
+{
+    const unsigned dx = (point.x - end.x);
+    const unsigned dy = (point.y - end.y);
+    return static_cast<unsigned>(
+        std::sqrt(static_cast<float>(dx * dx + dy * dy)));
+}
+
+dgm::WorldNavMesh::WorldNavMesh(dgm::Mesh _mesh, EmptyNetwork)
+    : mesh(std::move(_mesh))
+    , components(mesh)
+    , tileNodes(mesh.getDataSize().x * mesh.getDataSize().y, INVALID_NODE)
+{
+}
+
+dgm::WorldNavMesh::WorldNavMesh(dgm::Mesh _mesh, unsigned threadCount)
+    : WorldNavMesh(std::move(_mesh), EmptyNetwork {})
+{
+    // Row-major discovery keeps the nodes sorted
+    for (unsigned y = 1; y < mesh.getDataSize().y - 1; y++)
+    {
+        for (unsigned x = 1; x < mesh.getDataSize().x - 1; x++)
+        {
+            // Skip impassable blocks
+            if (mesh[{ x, y }] > 0) continue;
+
+            const sf::Vector2u point(x, y);
+            if (shouldRegisterAsJumpPoint(point))
+            {
+                tileNodes[y * mesh.getDataSize().x + x] =
+                    static_cast<NodeId>(nodeCoords.size());
+                nodeCoords.push_back(point);
+            }
+        }
+    }
+
+    appendAllNodeConnections(threadCount);
+}
+
+/**
+ *  Layout of the saved network, all values are 32-bit unsigned integers
+ *  in native byte order unless stated otherwise:
+ *
+ *  - magic bytes and format version
+ *  - mesh width, height, voxel width and voxel height
+ *  - 64-bit hash of the wall layout
+ *  - node count and edge count
+ *  - x, y and scan bounds (4 values) of each node
+ *  - edge offsets (node count + 1 values)
+ *  - destination node and distance of each edge
+ */
+static constexpr std::array<char, 8> NETWORK_FILE_MAGIC = {
+    'D', 'G', 'M', 'W', 'N', 'A', 'V', '\0'
 };
+static constexpr std::uint32_t NETWORK_FILE_VERSION = 1;
 
-struct TileNode
+/**
+ *  FNV-1a hash of walkability of all tiles, jump point network only
+ *  depends on which tiles are walls
+ */
+[[nodiscard]] static std::uint64_t getWallLayoutHash(const dgm::Mesh& mesh)
 {
-protected:
-    [[nodiscard]] constexpr static unsigned
-    getManhattanDistance(const sf::Vector2u& a, const sf::Vector2u& b) noexcept
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    const auto size = mesh.getDataSize();
+    for (unsigned y = 0; y < size.y; ++y)
     {
-        return custom::getScalarDistance(a.x, b.x)
-               + custom::getScalarDistance(a.y, b.y);
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            hash ^= mesh[{ x, y }] > 0 ? 1u : 0u;
+            hash *= 0x100000001b3ull;
+        }
     }
+    return hash;
+}
 
-public:
-    sf::Vector2u point = {};
-    unsigned gcost = 0;
-    unsigned hcost = 0;
-    unsigned fcost = 0;
-    Backdir backdir = Backdir::Up;
+template<class T, std::size_t Extent>
+static void writeValues(std::ostream& stream, std::span<T, Extent> values)
+{
+    stream.write(
+        reinterpret_cast<const char*>(values.data()),
+        static_cast<std::streamsize>(values.size_bytes()));
+}
 
-    TileNode() = default;
+template<class T, std::size_t Extent>
+[[nodiscard]] static bool
+readValues(std::istream& stream, std::span<T, Extent> values)
+{
+    return static_cast<bool>(stream.read(
+        reinterpret_cast<char*>(values.data()),
+        static_cast<std::streamsize>(values.size_bytes())));
+}
 
-    TileNode(
-        const sf::Vector2u& point,
-        const sf::Vector2u& end,
-        unsigned gcost,
-        Backdir backdir)
+std::expected<dgm::WorldNavMesh, dgm::Error>
+dgm::WorldNavMesh::loadFromFile(
+    dgm::Mesh mesh, const std::filesystem::path& path)
+{
+    auto&& fail = [&](const std::string& reason)
     {
-        this->point = point;
-        this->backdir = backdir;
-        this->gcost = gcost;
-        hcost = getManhattanDistance(point, end);
-        fcost = gcost + hcost;
+        return std::unexpected(dgm::Error(
+            "Could not load navmesh from '" + path.string() + "': " + reason));
+    };
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) return fail("Cannot open file");
+
+    std::array<char, NETWORK_FILE_MAGIC.size()> magic = {};
+    std::array<std::uint32_t, 5> header = {};
+    std::uint64_t wallLayoutHash = 0;
+    std::array<std::uint32_t, 2> counts = {};
+    if (!readValues(stream, std::span(magic))
+        || !readValues(stream, std::span(header))
+        || !readValues(stream, std::span(&wallLayoutHash, 1))
+        || !readValues(stream, std::span(counts)))
+        return fail("File is truncated");
+
+    const auto size = mesh.getDataSize();
+    const auto voxelSize = mesh.getVoxelSize();
+    if (magic != NETWORK_FILE_MAGIC) return fail("Not a navmesh file");
+    if (header[0] != NETWORK_FILE_VERSION)
+        return fail("Unsupported format version");
+    if (header[1] != size.x || header[2] != size.y
+        || header[3] != voxelSize.x || header[4] != voxelSize.y
+        || wallLayoutHash != getWallLayoutHash(mesh))
+        return fail("File was saved for a different mesh");
+
+    // Validating the size first prevents huge allocations caused by
+    // corrupted counts
+    const auto [nodeCount, edgeCount] = counts;
+    const std::uint64_t expectedFileSize =
+        static_cast<std::uint64_t>(stream.tellg())
+        + (nodeCount * 7ull + 1ull + edgeCount * 2ull)
+              * sizeof(std::uint32_t);
+    std::error_code error;
+    if (nodeCount > std::size_t { size.x } * size.y
+        || std::filesystem::file_size(path, error) != expectedFileSize)
+        return fail("File is corrupted");
+
+    std::vector<std::uint32_t> nodeData(std::size_t { nodeCount } * 6u);
+    std::vector<std::uint32_t> offsets(std::size_t { nodeCount } + 1u);
+    std::vector<std::uint32_t> edgeData(std::size_t { edgeCount } * 2u);
+    if (!readValues(stream, std::span(nodeData))
+        || !readValues(stream, std::span(offsets))
+        || !readValues(stream, std::span(edgeData)))
+        return fail("File is truncated");
+
+    auto navmesh = WorldNavMesh(std::move(mesh), EmptyNetwork {});
+    navmesh.nodeCoords.reserve(nodeCount);
+    navmesh.nodeScanBounds.reserve(nodeCount);
+    for (NodeId node = 0; node < nodeCount; ++node)
+    {
+        const auto* data = nodeData.data() + std::size_t { node } * 6u;
+        const auto point = sf::Vector2u(data[0], data[1]);
+        const auto scanBounds = TileBounds {
+            .topLeft = { data[2], data[3] },
+            .bottomRight = { data[4], data[5] },
+        };
+        const bool isSorted =
+            node == 0
+            || std::pair(point.y, point.x)
+                   > std::pair(
+                       navmesh.nodeCoords.back().y,
+                       navmesh.nodeCoords.back().x);
+        if (point.x >= size.x || point.y >= size.y || !isSorted
+            || navmesh.mesh[point] > 0)
+            return fail("File is corrupted");
+
+        // Scan bounds select nodes to rediscover in applyChanges, they
+        // always contain the node and reach at most one tile past the mesh,
+        // since neighbors of the examined tiles are included
+        if (scanBounds.topLeft.x > point.x || scanBounds.topLeft.y > point.y
+            || scanBounds.bottomRight.x < point.x
+            || scanBounds.bottomRight.y < point.y
+            || scanBounds.bottomRight.x > size.x
+            || scanBounds.bottomRight.y > size.y)
+            return fail("File is corrupted");
+
+        navmesh.tileNodes[point.y * size.x + point.x] = node;
+        navmesh.nodeCoords.push_back(point);
+        navmesh.nodeScanBounds.push_back(scanBounds);
     }
 
-    TileNode(const TileNode& other) = default;
-    TileNode& operator=(const TileNode& other) = default;
+    if (offsets.front() != 0 || offsets.back() != edgeCount
+        || !std::is_sorted(offsets.begin(), offsets.end()))
+        return fail("File is corrupted");
+    navmesh.edgeOffsets = std::move(offsets);
 
-    [[nodiscard]] constexpr bool
-    isCloserThan(const TileNode& other) const noexcept
+    navmesh.edges.reserve(edgeCount);
+    for (std::size_t i = 0; i < edgeData.size(); i += 2)
     {
-        return fcost < other.fcost
-               || (fcost == other.fcost && hcost < other.hcost);
+        if (edgeData[i] >= nodeCount) return fail("File is corrupted");
+        navmesh.edges.push_back(Connection {
+            .destination = navmesh.nodeCoords[edgeData[i]],
+            .distance = edgeData[i + 1],
+        });
     }
-};
 
-std::optional<dgm::Path<dgm::TileNavpoint>> dgm::TileNavMesh::computePath(
-    const sf::Vector2u& from, const sf::Vector2u& to, const dgm::Mesh& mesh)
+    return navmesh;
+}
+
+dgm::ExpectedSuccess
+dgm::WorldNavMesh::saveToFile(const std::filesystem::path& path) const
 {
-    if (mesh[from] == 1)
+    if (hasPendingChanges())
+        return std::unexpected(dgm::Error(
+            "Cannot save navmesh with pending changes, call applyChanges"));
+
+    std::vector<std::uint32_t> nodeData;
+    nodeData.reserve(nodeCoords.size() * 6u);
+    for (NodeId node = 0; node < nodeCoords.size(); ++node)
+    {
+        const auto& bounds = nodeScanBounds[node];
+        nodeData.insert(
+            nodeData.end(),
+            { nodeCoords[node].x,
+              nodeCoords[node].y,
+              bounds.topLeft.x,
+              bounds.topLeft.y,
+              bounds.bottomRight.x,
+              bounds.bottomRight.y });
+    }
+
+    std::vector<std::uint32_t> edgeData;
+    edgeData.reserve(edges.size() * 2u);
+    for (auto&& edge : edges)
+    {
+        edgeData.push_back(getNode(edge.destination));
+        edgeData.push_back(edge.distance);
+    }
+
+    const auto size = mesh.getDataSize();
+    const auto voxelSize = mesh.getVoxelSize();
+    const auto header = std::array<std::uint32_t, 5> {
+        NETWORK_FILE_VERSION, size.x, size.y, voxelSize.x, voxelSize.y
+    };
+    const std::uint64_t wallLayoutHash = getWallLayoutHash(mesh);
+    const auto counts = std::array<std::uint32_t, 2> {
+        static_cast<std::uint32_t>(nodeCoords.size()),
+        static_cast<std::uint32_t>(edges.size())
+    };
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    writeValues(stream, std::span(NETWORK_FILE_MAGIC));
+    writeValues(stream, std::span(header));
+    writeValues(stream, std::span(&wallLayoutHash, 1));
+    writeValues(stream, std::span(counts));
+    writeValues(stream, std::span(nodeData));
+    writeValues(stream, std::span(edgeOffsets));
+    writeValues(stream, std::span(edgeData));
+    stream.close();
+
+    if (!stream)
+        return std::unexpected(dgm::Error(
+            "Could not save navmesh to '" + path.string() + "'"));
+    return std::true_type {};
+}
+
+dgm::Path<dgm::WorldNavpoint> dgm::WorldNavMesh::computePath(
+    const sf::Vector2f& from, const sf::Vector2f& to) const
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computePath(from, to, context);
+}
+
+dgm::Path<dgm::WorldNavpoint> dgm::WorldNavMesh::computePath(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    PathfindingContext& context) const
+{
+    const auto&& tileFrom = toTileCoord(from);
+    const auto&& tileTo = toTileCoord(to);
+
+    // Identity, or no path at all
+    if (tileFrom == tileTo || !searchNetwork(tileFrom, tileTo, context))
+        return dgm::Path<WorldNavpoint>(
+            {}, false); // should be nullopt, but only since c++20
+
+    std::vector<WorldNavpoint> points;
+    for (auto&& point : reconstructPath(context, tileFrom, tileTo))
+        points.push_back(toWorldNavpoint(point));
+
+    return dgm::Path<WorldNavpoint>(std::move(points), false);
+}
+
+std::optional<unsigned> dgm::WorldNavMesh::searchNetwork(
+    const sf::Vector2u& tileFrom,
+    const sf::Vector2u& tileTo,
+    PathfindingContext& context) const
+{
+    assert(tileFrom != tileTo);
+
+    // Early search pruning
+    if (mesh[tileTo] > 0) // Destination is a wall
+        return std::nullopt;
+    // Agent standing within a wall can still escape to any region around
+    // it, so only the searches from passable tiles can be rejected
+    else if (
+        mesh[tileFrom] <= 0 && areComponentsUpToDate(components, mesh)
+        && !components.areConnected(tileFrom, tileTo))
         return std::nullopt;
-    else if (from == to)
-        return dgm::Path<TileNavpoint>({}, false);
 
-    auto updateOpenSetWithCoord =
-        [&](NodeSet<TileNode>& openSet,
-            const sf::Vector2u& coord,
-            const NodeSet<TileNode>& closedSet) -> void
+    // Unless from/to points are jump points, they need to be plugged into
+    // the network. Those auxiliary connections are only kept for the
+    // duration of this query so the network itself is never modified.
+    // Connections are symmetric, so connections discovered from the
+    // destination are also the connections leading into it.
+    const auto&& connectionsToDestination =
+        isJumpPoint(tileTo) ? std::vector<Connection> {}
+                            : discoverConnectionsForJumpPoint(tileTo);
+
+    // At this point, destination is virtually connected to the network.
+    // Discovery from the source will plug the source to the network and
+    // with a little luck, it might find a direct path to the destination.
+    const auto&& connectionsFromSource =
+        isJumpPoint(tileFrom)
+            ? std::vector<Connection> {}
+            : discoverConnectionsForJumpPoint(tileFrom, tileTo);
+
+    // Triangle inequality d(L, to) <= d(L, p) + d(p, to) yields a lower
+    // bound of the remaining distance for every landmark L. Evaluating
+    // all landmarks for every opened node costs more than it saves, so
+    // only the landmarks giving the best bound for the source are used.
+    const auto activeLandmarks = getActiveLandmarks(
+        getLandmarkDistances(tileFrom, connectionsFromSource),
+        getLandmarkDistances(tileTo, connectionsToDestination));
+
+    auto&& getHcost = [&](const sf::Vector2u& point)
     {
-        using NeighborType = std::pair<sf::Vector2u, Backdir>;
+        unsigned hcost = getWorldHcost(point, tileTo);
+        const NodeId node = getNode(point);
+        if (node == INVALID_NODE || point == tileTo) return hcost;
 
-        auto canVisit = [&](const sf::Vector2u& point)
+        const auto distances = std::span(landmarkDistances)
+                                   .subspan(node * landmarks.size());
+        for (auto&& [landmark, toDestination] : activeLandmarks)
         {
-            const bool notInClosedSet = !closedSet.contains(point);
-            const bool emptyInMesh = mesh[point] <= 0;
-            return notInClosedSet && emptyInMesh;
-        };
+            if (distances[landmark] < toDestination)
+                hcost = std::max(hcost, toDestination - distances[landmark]);
+        }
+        return hcost;
+    };
 
-        const TileNode& node = closedSet.getNode(coord);
-
-        // Direction points from Vector2u to node.point
-        const std::array<NeighborType, 4> neighbors = {
-            NeighborType(
-                sf::Vector2u(node.point.x, node.point.y - 1), Backdir::Down),
-            NeighborType(
-                sf::Vector2u(node.point.x, node.point.y + 1), Backdir::Up),
-            NeighborType(
-                sf::Vector2u(node.point.x - 1, node.point.y), Backdir::Right),
-            NeighborType(
-                sf::Vector2u(node.point.x + 1, node.point.y), Backdir::Left)
+    // A*
+    auto&& insertConnectionsIntoOpenSetIfNotClosedAlready =
+        [&](PathfindingContext& ctx, IndexType index)
+    {
+        const unsigned gcost = ctx.getGcost(index);
+        const sf::Vector2u coord = ctx.toCoord(index);
+
+        auto&& tryOpenNode = [&](const Connection& conn)
+        {
+            // Do not re-evaluate node which we've already visited on
+            // faster route
+            const IndexType destinationIndex = ctx.toIndex(conn.destination);
+            if (ctx.isClosed(destinationIndex)) return;
+
+            ctx.openNode(
+                destinationIndex,
+                gcost + conn.distance,
+                getHcost(conn.destination),
+                index);
         };
 
-        for (auto&& [newCoord, backdir] : neighbors)
+        // Source is the only expanded node that is not part of the network
+        const NodeId node = getNode(coord);
+        const auto connections =
+            node != INVALID_NODE
+                ? getNodeConnections(node)
+                : std::span<const Connection>(connectionsFromSource);
+        for (auto&& conn : connections)
+            tryOpenNode(conn);
+
+        for (auto&& conn : connectionsToDestination)
         {
-            if (canVisit(newCoord))
-                openSet.insertNode(
-                    TileNode(newCoord, to, node.gcost + 1, backdir));
+            if (conn.destination == coord)
+                tryOpenNode(Connection(tileTo, conn.distance));
         }
     };
 
-    const NodeSet<TileNode> closedSet = astarSearch<TileNode>(
-        TileNode(from, to, 0, Backdir::Undefined), to, updateOpenSetWithCoord);
+    const bool found = astarSearch(
+        context,
+        tileFrom,
+        tileTo,
+        mesh.getDataSize(),
+        getHcost(tileFrom),
+        insertConnectionsIntoOpenSetIfNotClosedAlready);
+    if (!found) return std::nullopt;
 
-    if (!closedSet.hasElements()) return std::nullopt;
+    return context.getGcost(context.toIndex(tileTo));
+}
 
-    std::vector<TileNavpoint> points;
-    points.push_back(TileNavpoint(to, 0u));
+dgm::Path<dgm::WorldNavpoint> dgm::WorldNavMesh::computePath(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    PathCache<WorldNavpoint>& cache) const
+{
+    assert(!hasPendingChanges());
+
+    // Path only depends on the tiles of the endpoints
+    auto&& result = cache.getOrCompute(
+        toTileCoord(from),
+        toTileCoord(to),
+        0u,
+        mesh.getVersion(),
+        [&](PathfindingContext& context)
+        {
+            return std::optional<dgm::Path<WorldNavpoint>>(
+                computePath(from, to, context));
+        });
+    return std::move(*result);
+}
 
-    sf::Vector2u point = to;
-    do
+std::vector<dgm::Path<dgm::WorldNavpoint>> dgm::WorldNavMesh::computePaths(
+    std::span<const PathRequest> requests, unsigned threadCount) const
+{
+    std::vector<Path<WorldNavpoint>> paths;
+    paths.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+        paths.emplace_back(std::vector<WorldNavpoint> {}, false);
+
+    threadCount = std::clamp(
+        threadCount,
+        1u,
+        std::max(1u, static_cast<unsigned>(requests.size())));
+
+    // Each worker owns its context and picks up requests until there are
+    // none left, so the work is balanced even if some queries are longer
+    std::atomic_size_t nextRequest = 0;
+    auto&& worker = [&]
     {
-        const TileNode& node = closedSet.getNode(point);
-        switch (node.backdir)
+        auto&& context = PathfindingContext(mesh.getDataSize());
+        for (std::size_t i = nextRequest++; i < requests.size();
+             i = nextRequest++)
         {
-        case Backdir::Up:
-            --point.y;
-            break;
-        case Backdir::Left:
-            --point.x;
-            break;
-        case Backdir::Down:
-            ++point.y;
-            break;
-        case Backdir::Right:
-            ++point.x;
-            break;
-        case Backdir::Undefined:
-            break;
+            paths[i] =
+                computePath(requests[i].from, requests[i].to, context);
         }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned i = 1; i < threadCount; ++i)
+            workers.emplace_back(worker);
+        worker();
+    }
 
-        if (point == from) break;
-        points.push_back(TileNavpoint(point, 0u));
-    } while (true);
-    std::reverse(points.begin(), points.end());
+    return paths;
+}
 
-    return dgm::Path(points, false);
+std::optional<float> dgm::WorldNavMesh::computeDistance(
+    const sf::Vector2f& from, const sf::Vector2f& to) const
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computeDistance(from, to, context);
 }
 
-// ========= WORLD NAVMESH ===========
+std::optional<float> dgm::WorldNavMesh::computeDistance(
+    const sf::Vector2f& from,
+    const sf::Vector2f& to,
+    PathfindingContext& context) const
+{
+    const auto&& tileFrom = toTileCoord(from);
+    const auto&& tileTo = toTileCoord(to);
+    if (tileFrom == tileTo) return 0.f;
+
+    const auto distance = searchNetwork(tileFrom, tileTo, context);
+    if (!distance) return std::nullopt;
+    return static_cast<float>(*distance);
+}
+
+std::vector<std::optional<float>> dgm::WorldNavMesh::computeDistances(
+    const sf::Vector2f& from, std::span<const sf::Vector2f> targets) const
+{
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    return computeDistances(from, targets, context);
+}
+
+std::vector<std::optional<float>> dgm::WorldNavMesh::computeDistances(
+    const sf::Vector2f& from,
+    std::span<const sf::Vector2f> targets,
+    PathfindingContext& context) const
+{
+    using TileIndex = std::pair<IndexType, std::size_t>;
+
+    // Connection from a tile into a target that is not part of the network
+    struct TargetConnection
+    {
+        IndexType from;
+        IndexType target;
+        unsigned distance;
+
+        [[nodiscard]] constexpr bool
+        operator<(const TargetConnection& other) const noexcept
+        {
+            return from < other.from;
+        }
+    };
+
+    const auto tileFrom = toTileCoord(from);
+    auto distances = std::vector<std::optional<float>>(targets.size());
+
+    dgm::priv::beginAstarSearch(context, tileFrom, mesh.getDataSize(), 0u);
+
+    // Targets are plugged into the network the same way as the destination
+    // of computePath. Discovering from the target with the source treated
+    // as a jump point also finds the direct connections from the source.
+    std::vector<TileIndex> pendingTargets;
+    std::vector<TargetConnection> targetConnections;
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        const auto tileTo = toTileCoord(targets[i]);
+        if (tileTo == tileFrom)
+        {
+            distances[i] = 0.f;
+            continue;
+        }
+        else if (
+            mesh[tileTo] > 0
+            || (mesh[tileFrom] <= 0 && areComponentsUpToDate(components, mesh)
+                && !components.areConnected(tileFrom, tileTo)))
+            continue;
+
+        const IndexType targetIndex = context.toIndex(tileTo);
+        pendingTargets.emplace_back(targetIndex, i);
+        if (isJumpPoint(tileTo)) continue;
+
+        for (auto&& conn : discoverConnectionsForJumpPoint(tileTo, tileFrom))
+        {
+            targetConnections.push_back(TargetConnection {
+                context.toIndex(conn.destination),
+                targetIndex,
+                conn.distance });
+        }
+    }
+    std::sort(pendingTargets.begin(), pendingTargets.end());
+    std::sort(targetConnections.begin(), targetConnections.end());
+
+    const auto connectionsFromSource =
+        isJumpPoint(tileFrom) ? std::vector<Connection> {}
+                              : discoverConnectionsForJumpPoint(tileFrom);
+
+    // Dijkstra, nodes are closed in the order of their distance
+    std::size_t pendingCount = pendingTargets.size();
+    while (pendingCount > 0 && context.hasOpenNodes())
+    {
+        const IndexType index = context.popBestNode();
+        const unsigned gcost = context.getGcost(index);
+
+        for (auto itr = std::lower_bound(
+                 pendingTargets.begin(),
+                 pendingTargets.end(),
+                 TileIndex(index, 0));
+             itr != pendingTargets.end() && itr->first == index;
+             ++itr)
+        {
+            distances[itr->second] = static_cast<float>(gcost);
+            --pendingCount;
+        }
+
+        auto&& tryOpenNode = [&](IndexType successor, unsigned distance)
+        {
+            if (context.isClosed(successor)) return;
+            context.openNode(successor, gcost + distance, 0u, index);
+        };
+
+        // Targets outside of the network are dead ends
+        const sf::Vector2u coord = context.toCoord(index);
+        const NodeId node = getNode(coord);
+        auto connections = std::span<const Connection>();
+        if (node != INVALID_NODE)
+            connections = getNodeConnections(node);
+        else if (coord == tileFrom)
+            connections = connectionsFromSource;
+        for (auto&& conn : connections)
+            tryOpenNode(context.toIndex(conn.destination), conn.distance);
+
+        for (auto itr = std::lower_bound(
+                 targetConnections.begin(),
+                 targetConnections.end(),
+                 TargetConnection { index, 0u, 0u });
+             itr != targetConnections.end() && itr->from == index;
+             ++itr)
+        {
+            tryOpenNode(itr->target, itr->distance);
+        }
+    }
 
-struct WorldNode
+    return distances;
+}
+
+void dgm::WorldNavMesh::setTile(const sf::Vector2u& tile, int value)
 {
-    sf::Vector2u point = {};
-    sf::Vector2u predecessor = {};
-    unsigned gcost = 0;
-    unsigned hcost = 0;
-    unsigned fcost = 0;
+    if (mesh[tile] == value) return;
 
-    WorldNode() = default;
+    mesh.setTile(tile, value);
+    if (dirtyBounds)
+        dirtyBounds->extend(tile);
+    else
+        dirtyBounds = TileBounds { tile, tile };
+}
 
-    WorldNode(
-        const sf::Vector2u& _point,
-        const sf::Vector2u& pred,
-        const sf::Vector2u& end,
-        unsigned _gcost)
-        : point(_point), predecessor(pred), gcost(_gcost)
+void dgm::WorldNavMesh::applyChanges()
+{
+    if (!dirtyBounds) return;
+
+    // Whether a tile is a jump point depends on its eight neighbors, so
+    // changed tiles affect one tile wide ring around them
+    const sf::Vector2u size = mesh.getDataSize();
+    const auto affectedBounds = TileBounds {
+        .topLeft = { std::max(dirtyBounds->topLeft.x, 1u) - 1,
+                     std::max(dirtyBounds->topLeft.y, 1u) - 1 },
+        .bottomRight = { std::min(dirtyBounds->bottomRight.x + 1, size.x - 1),
+                         std::min(dirtyBounds->bottomRight.y + 1, size.y - 1) },
+    };
+    components.update(mesh, dirtyBounds->topLeft, dirtyBounds->bottomRight);
+    dirtyBounds.reset();
+
+    // Border tiles are never jump points. Added jump points get a
+    // temporary id, they are numbered when the nodes are merged below.
+    constexpr NodeId ADDED_NODE = INVALID_NODE - 1;
+    std::vector<sf::Vector2u> addedPoints;
+    for (unsigned y = std::max(affectedBounds.topLeft.y, 1u);
+         y <= std::min(affectedBounds.bottomRight.y, size.y - 2);
+         ++y)
     {
-        const unsigned dx = (point.x - end.x);
-        const unsigned dy = (point.y - end.y);
-        hcost = static_cast<unsigned>(
-            std::sqrt(static_cast<float>(dx * dx + dy * dy)));
-        fcost = gcost + hcost;
+        for (unsigned x = std::max(affectedBounds.topLeft.x, 1u);
+             x <= std::min(affectedBounds.bottomRight.x, size.x - 2);
+             ++x)
+        {
+            const sf::Vector2u point(x, y);
+            const bool shouldBeJumpPoint =
+                mesh[point] <= 0 && shouldRegisterAsJumpPoint(point);
+            if (shouldBeJumpPoint == isJumpPoint(point)) continue;
+
+            if (shouldBeJumpPoint) addedPoints.push_back(point);
+            tileNodes[y * size.x + x] =
+                shouldBeJumpPoint ? ADDED_NODE : INVALID_NODE;
+        }
     }
 
-    WorldNode(const WorldNode& other) = default;
+    const auto oldCoords = std::exchange(nodeCoords, {});
+    const auto oldScanBounds = std::exchange(nodeScanBounds, {});
+    const auto oldOffsets = std::exchange(edgeOffsets, { 0u });
+    const auto oldEdges = std::exchange(edges, {});
+
+    // Both the surviving and the added nodes are sorted, merging them
+    // keeps the new node list sorted. Previous id of each node is kept so
+    // its connections can be reused.
+    auto&& isBefore = [](const sf::Vector2u& a, const sf::Vector2u& b)
+    { return a.y < b.y || (a.y == b.y && a.x < b.x); };
 
-    [[nodiscard]] constexpr bool
-    isCloserThan(const WorldNode& other) const noexcept
+    std::vector<NodeId> previousIds;
+    previousIds.reserve(oldCoords.size() + addedPoints.size());
+    nodeCoords.reserve(oldCoords.size() + addedPoints.size());
+
+    auto addedItr = addedPoints.begin();
+    for (NodeId oldId = 0; oldId <= oldCoords.size(); ++oldId)
     {
-        return fcost < other.fcost
-               || (fcost == other.fcost && hcost < other.hcost);
+        const bool isLast = oldId == oldCoords.size();
+        while (addedItr != addedPoints.end()
+               && (isLast || isBefore(*addedItr, oldCoords[oldId])))
+        {
+            nodeCoords.push_back(*addedItr++);
+            previousIds.push_back(INVALID_NODE);
+        }
+
+        if (isLast || !isJumpPoint(oldCoords[oldId])) continue;
+        nodeCoords.push_back(oldCoords[oldId]);
+        previousIds.push_back(oldId);
     }
-};
 
-dgm::WorldNavMesh::WorldNavMesh(dgm::Mesh _mesh) : mesh(std::move(_mesh))
-{
-    auto shouldRegisterAsJumpPoint = [&](const sf::Vector2u& point)
-    {
-        /**
-         *  Test if this point is at the tip of some impassable tile, eg:
-         *  #   #
-         *  # p     <-- there the p is corner point
-         *  # # #
-         *
-         *
-         *  #   #
-         *  # p #   <-- there p is not a corner point
-         *  #   #
-         *
-         *  #   #
-         *    p     <-- multiple corners
-         *  # # #
-         */
-
-        const bool northOpened = mesh[{ point.x, point.y - 1 }] <= 0;
-        const bool westOpened = mesh[{ point.x - 1, point.y }] <= 0;
-        const bool southOpened = mesh[{ point.x, point.y + 1 }] <= 0;
-        const bool eastOpened = mesh[{ point.x + 1, point.y }] <= 0;
-        const bool northWestCorner =
-            mesh[{ point.x - 1, point.y - 1 }] > 0 && westOpened && northOpened;
-        const bool northEastCorner =
-            mesh[{ point.x + 1, point.y - 1 }] > 0 && eastOpened && northOpened;
-        const bool southWestCorner =
-            mesh[{ point.x - 1, point.y + 1 }] > 0 && westOpened && southOpened;
-        const bool southEastCorner =
-            mesh[{ point.x + 1, point.y + 1 }] > 0 && eastOpened && southOpened;
-
-        return northWestCorner || northEastCorner || southWestCorner
-               || southEastCorner;
+    for (NodeId node = 0; node < nodeCoords.size(); ++node)
+    {
+        const auto& point = nodeCoords[node];
+        tileNodes[point.y * size.x + point.x] = node;
+    }
+
+    // Any jump point whose connections could have changed must have
+    // examined either a changed tile or a tile which is (or was) a jump
+    // point. Freshly added jump points have no scan bounds yet.
+    for (NodeId node = 0; node < nodeCoords.size(); ++node)
+    {
+        const NodeId oldId = previousIds[node];
+        if (oldId == INVALID_NODE
+            || oldScanBounds[oldId].intersects(affectedBounds))
+        {
+            appendNodeConnections(node);
+            continue;
+        }
+
+        edges.insert(
+            edges.end(),
+            oldEdges.begin() + oldOffsets[oldId],
+            oldEdges.begin() + oldOffsets[oldId + 1]);
+        edgeOffsets.push_back(static_cast<std::uint32_t>(edges.size()));
+        nodeScanBounds.push_back(oldScanBounds[oldId]);
+    }
+
+    // Both landmarks and distances between nodes could have changed
+    if (!landmarks.empty()) computeLandmarks(getLandmarkCount());
+}
+
+std::vector<unsigned> dgm::WorldNavMesh::getLandmarkDistances(
+    const sf::Vector2u& point, std::span<const Connection> connections) const
+{
+    const std::size_t landmarkCount = landmarks.size();
+    if (const NodeId node = getNode(point); node != INVALID_NODE)
+    {
+        const auto itr = landmarkDistances.begin() + node * landmarkCount;
+        return std::vector<unsigned>(itr, itr + landmarkCount);
+    }
+
+    // Any path between the point and a landmark goes through one of the
+    // connections of the point. Connections can lead to auxiliary points
+    // which are not part of the network.
+    auto&& result = std::vector<unsigned>(landmarkCount, UNREACHABLE);
+    for (auto&& conn : connections)
+    {
+        const NodeId neighbor = getNode(conn.destination);
+        if (neighbor == INVALID_NODE) continue;
+        for (std::size_t i = 0; i < landmarkCount; ++i)
+        {
+            const unsigned distance =
+                landmarkDistances[neighbor * landmarkCount + i];
+            if (distance == UNREACHABLE) continue;
+            result[i] = std::min(result[i], distance + conn.distance);
+        }
+    }
+    return result;
+}
+
+std::vector<dgm::WorldNavMesh::ActiveLandmark>
+dgm::WorldNavMesh::getActiveLandmarks(
+    const std::vector<unsigned>& sourceDistances,
+    const std::vector<unsigned>& destinationDistances) const
+{
+    std::vector<ActiveLandmark> result;
+    for (std::size_t i = 0; i < landmarks.size(); ++i)
+    {
+        // Landmarks unreachable from the destination bound nothing
+        if (destinationDistances[i] == UNREACHABLE) continue;
+        result.push_back(ActiveLandmark {
+            .landmark = static_cast<unsigned>(i),
+            .toDestination = destinationDistances[i],
+        });
+    }
+
+    auto&& getBound = [&](const ActiveLandmark& active)
+    {
+        const unsigned toSource = sourceDistances[active.landmark];
+        return toSource < active.toDestination
+                   ? active.toDestination - toSource
+                   : 0u;
     };
 
-    auto discoverJumpPoints = [&]
+    std::ranges::stable_sort(
+        result,
+        [&](const ActiveLandmark& a, const ActiveLandmark& b)
+        { return getBound(a) > getBound(b); });
+    result.resize(std::min(result.size(), ACTIVE_LANDMARK_COUNT));
+    return result;
+}
+
+void dgm::WorldNavMesh::computeLandmarks(unsigned landmarkCount)
+{
+    const std::size_t nodeCount = nodeCoords.size();
+    const std::size_t count =
+        std::min(static_cast<std::size_t>(landmarkCount), nodeCount);
+    landmarks.clear();
+    landmarkDistances.assign(nodeCount * count, UNREACHABLE);
+    if (count == 0) return;
+
+    // Dijkstra over the network, nodes are addressed by their tiles
+    auto&& context = PathfindingContext(mesh.getDataSize());
+    std::vector<unsigned> distances(nodeCount);
+    auto&& computeDistancesFrom = [&](NodeId source)
     {
-        for (unsigned y = 1; y < mesh.getDataSize().y - 1; y++)
+        std::ranges::fill(distances, UNREACHABLE);
+        context.beginSearch(mesh.getDataSize());
+        const IndexType sourceIndex = context.toIndex(nodeCoords[source]);
+        context.openNode(sourceIndex, 0u, 0u, sourceIndex);
+
+        while (context.hasOpenNodes())
         {
-            for (unsigned x = 1; x < mesh.getDataSize().x - 1; x++)
-            {
-                // Skip impassable blocks
-                if (mesh[{ x, y }] > 0) continue;
+            const IndexType index = context.popBestNode();
+            const NodeId node = tileNodes[index];
+            distances[node] = context.getGcost(index);
 
-                const sf::Vector2u point(x, y);
-                if (shouldRegisterAsJumpPoint(point))
-                {
-                    jumpPointConnections[point] = {};
-                }
+            for (auto&& conn : getNodeConnections(node))
+            {
+                const IndexType next = context.toIndex(conn.destination);
+                if (context.isClosed(next)) continue;
+                context.openNode(
+                    next, distances[node] + conn.distance, 0u, index);
             }
         }
     };
 
-    discoverJumpPoints();
+    // Max element is the first one, so ties are broken by node ids
+    auto&& getFarthestNode = [](const std::vector<unsigned>& values)
+    {
+        return static_cast<NodeId>(
+            std::ranges::max_element(values) - values.begin());
+    };
 
-    for (auto&& [point, _] : jumpPointConnections)
-        discoverConnectionsForJumpPoint(point, false);
+    // Farthest point selection. Nodes not reachable from any landmark
+    // are the farthest ones, so every isolated part of the network gets
+    // a landmark while there are some left.
+    computeDistancesFrom(0);
+    NodeId nextLandmark = getFarthestNode(distances);
+    std::vector<unsigned> nearestLandmarkDistances(nodeCount, UNREACHABLE);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        landmarks.push_back(nextLandmark);
+        computeDistancesFrom(nextLandmark);
+        for (NodeId node = 0; node < nodeCount; ++node)
+        {
+            landmarkDistances[node * count + i] = distances[node];
+            nearestLandmarkDistances[node] =
+                std::min(nearestLandmarkDistances[node], distances[node]);
+        }
+        nextLandmark = getFarthestNode(nearestLandmarkDistances);
+    }
 }
 
-static dgm::Path<dgm::WorldNavpoint> convertRawPathToWorldPath(
-    const NodeSet<WorldNode>& rawPath,
-    const sf::Vector2u& tileFrom,
-    const sf::Vector2u& tileTo,
-    std::function<dgm::WorldNavpoint(const sf::Vector2u&)> toWorldNavpoint)
+bool dgm::WorldNavMesh::shouldRegisterAsJumpPoint(
+    const sf::Vector2u& point) const
 {
-    if (!rawPath.hasElements())
-        return dgm::Path<dgm::WorldNavpoint>(
-            {}, false); // should be nullopt (c++20)
+    /**
+     *  Test if this point is at the tip of some impassable tile, eg:
+     *  #   #
+     *  # p     <-- there the p is corner point
+     *  # # #
+     *
+     *
+     *  #   #
+     *  # p #   <-- there p is not a corner point
+     *  #   #
+     *
+     *  #   #
+     *    p     <-- multiple corners
+     *  # # #
+     */
+
+    const bool northOpened = mesh[{ point.x, point.y - 1 }] <= 0;
+    const bool westOpened = mesh[{ point.x - 1, point.y }] <= 0;
+    const bool southOpened = mesh[{ point.x, point.y + 1 }] <= 0;
+    const bool eastOpened = mesh[{ point.x + 1, point.y }] <= 0;
+    const bool northWestCorner =
+        mesh[{ point.x - 1, point.y - 1 }] > 0 && westOpened && northOpened;
+    const bool northEastCorner =
+        mesh[{ point.x + 1, point.y - 1 }] > 0 && eastOpened && northOpened;
+    const bool southWestCorner =
+        mesh[{ point.x - 1, point.y + 1 }] > 0 && westOpened && southOpened;
+    const bool southEastCorner =
+        mesh[{ point.x + 1, point.y + 1 }] > 0 && eastOpened && southOpened;
+
+    return northWestCorner || northEastCorner || southWestCorner
+           || southEastCorner;
+}
 
-    std::vector<dgm::WorldNavpoint> points;
-    points.push_back(toWorldNavpoint(tileTo));
+void dgm::WorldNavMesh::appendNodeConnections(NodeId node)
+{
+    assert(node + 1 == edgeOffsets.size());
 
-    sf::Vector2u point = tileTo;
-    do
-    {
-        const auto node = rawPath.getNode(point);
-        point = node.predecessor;
-        if (point == tileFrom) break;
-        points.push_back(toWorldNavpoint(point));
-    } while (true);
-    std::reverse(points.begin(), points.end());
+    const auto point = nodeCoords[node];
+    auto scanBounds = TileBounds { point, point };
+    const auto connections =
+        discoverConnectionsForJumpPoint(point, std::nullopt, &scanBounds);
 
-    return dgm::Path<dgm::WorldNavpoint>(points, false);
+    edges.insert(edges.end(), connections.begin(), connections.end());
+    edgeOffsets.push_back(static_cast<std::uint32_t>(edges.size()));
+    nodeScanBounds.push_back(scanBounds);
 }
 
-dgm::Path<dgm::WorldNavpoint>
-dgm::WorldNavMesh::computePath(const sf::Vector2f& from, const sf::Vector2f& to)
+void dgm::WorldNavMesh::appendAllNodeConnections(unsigned threadCount)
 {
-    const auto&& tileFrom = toTileCoord(from);
-    const auto&& tileTo = toTileCoord(to);
-    const auto&& wasTileFromOriginallyJumpPoint = isJumpPoint(tileFrom);
-    const auto&& wasTileToOriginallyJumpPoint = isJumpPoint(tileTo);
+    assert(edges.empty());
 
-    // Early search pruning
-    if (tileFrom == tileTo) // Identity
-        return dgm::Path<WorldNavpoint>({}, false);
-    else if (mesh[tileTo] > 0) // Destination is a wall
-        return dgm::Path<WorldNavpoint>(
-            {}, false); // should be nullopt, but only since c++20
+    // Nodes are handed out to the threads in blocks, each with its own
+    // buffers. Blocks are appended in the order of their nodes afterwards,
+    // so the edge arrays are the same as if they were built serially.
+    constexpr std::size_t BLOCK_SIZE = 64;
+
+    struct Block
+    {
+        std::vector<Connection> edges = {};
+        std::vector<std::uint32_t> edgeCounts = {};
+        std::vector<TileBounds> scanBounds = {};
+    };
 
-    connectToAndFromPointsToTheNetwork(tileFrom, tileTo);
+    const std::size_t nodeCount = nodeCoords.size();
+    auto blocks = std::vector<Block>((nodeCount + BLOCK_SIZE - 1) / BLOCK_SIZE);
 
-    // A*
-    auto&& insertCoordIntoOpenSetIfNotInClosedSetAlready =
-        [&](NodeSet<WorldNode>& openSet,
-            const sf::Vector2u& coord,
-            const NodeSet<WorldNode>& closedSet) -> void
+    std::atomic_size_t nextBlock = 0;
+    auto&& worker = [&]
     {
-        const auto node = closedSet.getNode(coord);
-        for (auto&& conn : jumpPointConnections[coord])
+        for (std::size_t i = nextBlock++; i < blocks.size(); i = nextBlock++)
         {
-            if (!closedSet.contains(
-                    conn.destination)) // Do not re-evaluate node which we've
-                                       // already visited on faster route
-                openSet.insertNode(WorldNode(
-                    conn.destination,
-                    coord,
-                    tileTo,
-                    node.gcost + static_cast<unsigned>(conn.distance)));
+            auto& block = blocks[i];
+            const std::size_t end = std::min((i + 1) * BLOCK_SIZE, nodeCount);
+            for (std::size_t node = i * BLOCK_SIZE; node < end; ++node)
+            {
+                const auto point = nodeCoords[node];
+                auto scanBounds = TileBounds { point, point };
+                const auto connections = discoverConnectionsForJumpPoint(
+                    point, std::nullopt, &scanBounds);
+
+                block.edges.insert(
+                    block.edges.end(), connections.begin(), connections.end());
+                block.edgeCounts.push_back(
+                    static_cast<std::uint32_t>(connections.size()));
+                block.scanBounds.push_back(scanBounds);
+            }
         }
     };
 
-    auto&& rawPath = astarSearch<WorldNode>(
-        WorldNode(tileFrom, {}, tileTo, 0),
-        tileTo,
-        insertCoordIntoOpenSetIfNotInClosedSetAlready);
+    threadCount = std::clamp(
+        threadCount,
+        1u,
+        std::max(1u, static_cast<unsigned>(blocks.size())));
 
-    eraseFromAndToPointsFromTheNetwork(
-        tileFrom,
-        wasTileFromOriginallyJumpPoint,
-        tileTo,
-        wasTileToOriginallyJumpPoint);
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned i = 1; i < threadCount; ++i)
+            workers.emplace_back(worker);
+        worker();
+    }
 
-    return convertRawPathToWorldPath(
-        rawPath,
-        tileFrom,
-        tileTo,
-        [&](const sf::Vector2u& vec) { return toWorldNavpoint(vec); });
+    std::size_t edgeCount = 0;
+    for (auto&& block : blocks)
+        edgeCount += block.edges.size();
+
+    edges.reserve(edgeCount);
+    edgeOffsets.reserve(nodeCount + 1);
+    nodeScanBounds.reserve(nodeCount);
+    for (auto&& block : blocks)
+    {
+        edges.insert(edges.end(), block.edges.begin(), block.edges.end());
+        for (auto&& count : block.edgeCounts)
+            edgeOffsets.push_back(edgeOffsets.back() + count);
+        nodeScanBounds.insert(
+            nodeScanBounds.end(),
+            block.scanBounds.begin(),
+            block.scanBounds.end());
+    }
 }
 
-void dgm::WorldNavMesh::discoverConnectionsForJumpPoint(
-    const sf::Vector2u& point, bool symmetricConnection)
+std::vector<dgm::WorldNavMesh::Connection>
+dgm::WorldNavMesh::discoverConnectionsForJumpPoint(
+    const sf::Vector2u& point,
+    const std::optional<sf::Vector2u>& auxiliaryJumpPoint,
+    TileBounds* scanBounds) const
 {
     using namespace dgm::priv;
 
+    std::vector<Connection> connections;
+
+    // Stop conditions also look at the direct neighbors of the seeker
+    auto&& markExamined = [&](const sf::Vector2u& seeker)
+    {
+        if (!scanBounds) return;
+        scanBounds->extend(
+            { std::max(seeker.x, 1u) - 1, std::max(seeker.y, 1u) - 1 });
+        scanBounds->extend({ seeker.x + 1, seeker.y + 1 });
+    };
+
     auto&& discoverConnectionsInDirection =
         [&](sf::Vector2u seeker,
             std::function<sf::Vector2u(const sf::Vector2u&)> advance,
@@ -440,11 +1769,13 @@ void dgm::WorldNavMesh::discoverConnectionsForJumpPoint(
     {
         while (true)
         {
+            markExamined(seeker);
             if (shouldStopAdvancing(seeker, mesh))
                 return seeker;
-            else if (isJumpPoint(seeker))
+            else if (isJumpPoint(seeker) || seeker == auxiliaryJumpPoint)
             {
-                connectTwoJumpPoints(point, seeker, symmetricConnection);
+                connections.push_back(
+                    Connection(seeker, getDistance(point, seeker)));
                 return seeker;
             }
             seeker = advance(seeker);
@@ -498,72 +1829,28 @@ void dgm::WorldNavMesh::discoverConnectionsForJumpPoint(
         discoverConnectionsInDirection(
             { x, point.y + 1 }, advanceDownRight, shouldStopDownRightDiscovery);
     }
+
+    return connections;
 }
 
-void dgm::WorldNavMesh::connectTwoJumpPoints(
-    const sf::Vector2u& a, const sf::Vector2u& b, bool symmetricConnection)
+unsigned dgm::WorldNavMesh::getDistance(
+    const sf::Vector2u& a, const sf::Vector2u& b) const
 {
     const float dx = (static_cast<float>(a.x) - b.x) * mesh.getVoxelSize().x;
     const float dy = (static_cast<float>(a.y) - b.y) * mesh.getVoxelSize().y;
-    const unsigned distance =
-        static_cast<unsigned>(std::sqrt(dx * dx + dy * dy));
-
-    if (symmetricConnection)
-        jumpPointConnections[b].push_back(Connection(a, distance));
-    jumpPointConnections[a].push_back(Connection(b, distance));
-}
-
-void dgm::WorldNavMesh::connectToAndFromPointsToTheNetwork(
-    const sf::Vector2u& tileFrom, const sf::Vector2u& tileTo)
-{
-    // Unless these points are jump points, connect them to the network
-    if (!isJumpPoint(tileTo))
-    {
-        // Destination needs to have connections from neighbors to itself
-        // reverse connections are only made for bookmarking so everything
-        // can be cleaned-up later
-        jumpPointConnections[tileTo] = {};
-        discoverConnectionsForJumpPoint(tileTo, true);
-    }
-
-    if (!isJumpPoint(tileFrom))
-    {
-        // At this point, destination is connected to the netwrok
-        // discovery at this point will plug the starting point to
-        // the network and with a little luck, it might find a
-        // direct path to the destination
-        discoverConnectionsForJumpPoint(tileFrom);
-    }
-}
-
-void dgm::WorldNavMesh::eraseFromAndToPointsFromTheNetwork(
-    const sf::Vector2u& tileFrom,
-    bool wasTileFromOriginallyJumpPoint,
-    const sf::Vector2u& tileTo,
-    bool wasTileToOriginallyJumpPoint)
-{
-    // Erase auxiliary connections created earlier, but only if from/to
-    // points weren't jump points to begin with
-    if (not wasTileToOriginallyJumpPoint)
-    {
-        for (auto&& conn : jumpPointConnections[tileTo])
-            jumpPointConnections[conn.destination].pop_back();
-        jumpPointConnections.erase(tileTo);
-    }
-
-    // source is connected in one-way only, sufficient to delete this node
-    if (not wasTileFromOriginallyJumpPoint)
-        jumpPointConnections.erase(tileFrom);
+    return static_cast<unsigned>(std::sqrt(dx * dx + dy * dy));
 }
 
-sf::Vector2u dgm::WorldNavMesh::toTileCoord(const sf::Vector2f& coord)
+sf::Vector2u
+dgm::WorldNavMesh::toTileCoord(const sf::Vector2f& coord) const
 {
     return sf::Vector2u(
         static_cast<unsigned>(coord.x) / mesh.getVoxelSize().x,
         static_cast<unsigned>(coord.y) / mesh.getVoxelSize().y);
 }
 
-dgm::WorldNavpoint dgm::WorldNavMesh::toWorldNavpoint(const sf::Vector2u& coord)
+dgm::WorldNavpoint
+dgm::WorldNavMesh::toWorldNavpoint(const sf::Vector2u& coord) const
 {
     return WorldNavpoint(
         sf::Vector2f(
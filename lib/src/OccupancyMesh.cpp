@@ -0,0 +1,75 @@
+#include "DGM/classes/OccupancyMesh.hpp"
+#include <algorithm>
+
+dgm::OccupancyMesh::OccupancyMesh(const dgm::Mesh& mesh)
+    : dataSize(mesh.getDataSize())
+    , voxelSize(mesh.getVoxelSize())
+    , position(mesh.getPosition())
+    , meshVersion(mesh.getVersion())
+    , wordsPerRow((dataSize.x + BITS_PER_WORD - 1) / BITS_PER_WORD)
+    , words(std::size_t { wordsPerRow } * dataSize.y, 0)
+{
+    // Whole words are assembled at once instead of setting bit by bit
+    const auto& data = mesh.getRawConstData();
+    for (unsigned y = 0; y < dataSize.y; ++y)
+    {
+        for (unsigned w = 0; w < wordsPerRow; ++w)
+        {
+            const unsigned from = w * BITS_PER_WORD;
+            const unsigned count = std::min(BITS_PER_WORD, dataSize.x - from);
+            const int* row = data.data() + y * dataSize.x + from;
+
+            WordType word = 0;
+            for (unsigned i = 0; i < count; ++i)
+                word |= WordType { row[i] > 0 } << i;
+            words[y * wordsPerRow + w] = word;
+        }
+    }
+}
+
+void dgm::OccupancyMesh::update(
+    const dgm::Mesh& mesh,
+    const sf::Vector2u& topLeft,
+    const sf::Vector2u& bottomRight)
+{
+    if (mesh.getDataSize() != dataSize)
+    {
+        *this = OccupancyMesh(mesh);
+        return;
+    }
+
+    for (unsigned y = topLeft.y; y <= std::min(bottomRight.y, dataSize.y - 1);
+         ++y)
+    {
+        for (unsigned x = topLeft.x;
+             x <= std::min(bottomRight.x, dataSize.x - 1);
+             ++x)
+        {
+            auto& word = words[y * wordsPerRow + x / BITS_PER_WORD];
+            const WordType bit = WordType { 1 } << (x % BITS_PER_WORD);
+            word = mesh[{ x, y }] > 0 ? word | bit : word & ~bit;
+        }
+    }
+
+    voxelSize = mesh.getVoxelSize();
+    position = mesh.getPosition();
+    meshVersion = mesh.getVersion();
+}
+
+std::size_t dgm::OccupancyMesh::countOccupiedTiles(
+    const sf::Vector2u& topLeft, const sf::Vector2u& bottomRight) const noexcept
+{
+    const unsigned firstWord = topLeft.x / BITS_PER_WORD;
+    const unsigned lastWord = bottomRight.x / BITS_PER_WORD;
+
+    std::size_t count = 0;
+    for (unsigned y = topLeft.y; y <= bottomRight.y; ++y)
+    {
+        for (unsigned w = firstWord; w <= lastWord; ++w)
+        {
+            count += static_cast<std::size_t>(std::popcount(
+                getWord(w, y) & getSpanMask(w, topLeft.x, bottomRight.x)));
+        }
+    }
+    return count;
+}
@@ -0,0 +1,198 @@
+#include "DGM/classes/PathFollowerSystem.hpp"
+#include "DGM/classes/Error.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+using AgentId = dgm::PathFollowerSystem::AgentId;
+
+static constexpr float IDLE_DISTANCE = std::numeric_limits<float>::infinity();
+
+AgentId dgm::PathFollowerSystem::addAgent(
+    const sf::Vector2f& position, float speed)
+{
+    if (!freeIds.empty())
+    {
+        const AgentId id = freeIds.back();
+        freeIds.pop_back();
+
+        positionsX[id] = position.x;
+        positionsY[id] = position.y;
+        speeds[id] = speed;
+        states[id] = State::Idle;
+        return id;
+    }
+
+    const auto id = static_cast<AgentId>(states.size());
+    positionsX.push_back(position.x);
+    positionsY.push_back(position.y);
+    directionsX.push_back(0.f);
+    directionsY.push_back(0.f);
+    distances.push_back(IDLE_DISTANCE);
+    speeds.push_back(speed);
+    states.push_back(State::Idle);
+    steps.push_back(0.f);
+    routes.emplace_back();
+    cursors.emplace_back();
+    return id;
+}
+
+void dgm::PathFollowerSystem::removeAgent(AgentId id)
+{
+    if (id >= states.size() || states[id] == State::Removed) return;
+
+    stop(id);
+    states[id] = State::Removed;
+    freeIds.push_back(id);
+}
+
+void dgm::PathFollowerSystem::setPath(
+    AgentId id, const dgm::Path<WorldNavpoint>& path)
+{
+    requireAgent(id);
+
+    if (path.isTraversed())
+    {
+        stop(id);
+        return;
+    }
+
+    routes[id] = path.getSharedPoints();
+    cursors[id] = path.getCursor();
+    states[id] = State::Moving;
+    aimAtCurrentPoint(id);
+}
+
+void dgm::PathFollowerSystem::stop(AgentId id)
+{
+    requireAgent(id);
+
+    states[id] = State::Idle;
+    routes[id].reset();
+    directionsX[id] = 0.f;
+    directionsY[id] = 0.f;
+    distances[id] = IDLE_DISTANCE;
+}
+
+std::span<const AgentId>
+dgm::PathFollowerSystem::update(const dgm::Time& time)
+{
+    const float deltaTime = time.getDeltaTime();
+    const std::size_t count = states.size();
+
+    float* const xs = positionsX.data();
+    float* const ys = positionsY.data();
+    float* const remaining = distances.data();
+    float* const travelled = steps.data();
+    const float* const dxs = directionsX.data();
+    const float* const dys = directionsY.data();
+    const float* const velocities = speeds.data();
+
+    // Two short branchless loops, because a single one touching all the
+    // arrays needs too many runtime aliasing checks to be vectorized.
+    // Idle agents have zero direction and infinite distance, so they stay
+    // in place and never reach anything.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float step = velocities[i] * deltaTime;
+        travelled[i] = std::min(step, remaining[i]);
+        remaining[i] -= step;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        xs[i] += dxs[i] * travelled[i];
+        ys[i] += dys[i] * travelled[i];
+    }
+
+    // Negative distance is how far the agent got past its waypoint
+    arrivals.clear();
+    for (AgentId id = 0; id < count; ++id)
+    {
+        if (remaining[id] <= 0.f) advanceToNextWaypoint(id, -remaining[id]);
+    }
+
+    return arrivals;
+}
+
+sf::Vector2f dgm::PathFollowerSystem::getPosition(AgentId id) const
+{
+    requireAgent(id);
+    return { positionsX[id], positionsY[id] };
+}
+
+void dgm::PathFollowerSystem::setPosition(
+    AgentId id, const sf::Vector2f& position)
+{
+    requireAgent(id);
+
+    positionsX[id] = position.x;
+    positionsY[id] = position.y;
+    if (states[id] == State::Moving) aimAtCurrentPoint(id);
+}
+
+void dgm::PathFollowerSystem::setSpeed(AgentId id, float speed)
+{
+    requireAgent(id);
+    speeds[id] = speed;
+}
+
+bool dgm::PathFollowerSystem::isMoving(AgentId id) const
+{
+    requireAgent(id);
+    return states[id] == State::Moving;
+}
+
+void dgm::PathFollowerSystem::requireAgent(AgentId id) const
+{
+    if (id >= states.size() || states[id] == State::Removed)
+        throw dgm::Exception("There is no agent with id " + std::to_string(id));
+}
+
+void dgm::PathFollowerSystem::aimAtCurrentPoint(AgentId id)
+{
+    const auto target = (*routes[id])[cursors[id].getIndex()].coord;
+    const float dx = target.x - positionsX[id];
+    const float dy = target.y - positionsY[id];
+    const float distance = std::sqrt(dx * dx + dy * dy);
+
+    directionsX[id] = distance > 0.f ? dx / distance : 0.f;
+    directionsY[id] = distance > 0.f ? dy / distance : 0.f;
+    distances[id] = distance;
+}
+
+void dgm::PathFollowerSystem::advanceToNextWaypoint(
+    AgentId id, float remainingDistance)
+{
+    const auto& points = *routes[id];
+    auto& cursor = cursors[id];
+
+    // Looping path is followed at most once per update, even if all of its
+    // points are at the same spot
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        // Reached waypoint is snapped to, so rounding errors don't add up
+        positionsX[id] = points[cursor.getIndex()].coord.x;
+        positionsY[id] = points[cursor.getIndex()].coord.y;
+
+        cursor.advance(points.size());
+        if (cursor.isTraversed(points.size()))
+        {
+            stop(id);
+            arrivals.push_back(id);
+            return;
+        }
+
+        aimAtCurrentPoint(id);
+        if (distances[id] > remainingDistance)
+        {
+            positionsX[id] += directionsX[id] * remainingDistance;
+            positionsY[id] += directionsY[id] * remainingDistance;
+            distances[id] -= remainingDistance;
+            return;
+        }
+
+        remainingDistance -= distances[id];
+    }
+}
@@ -0,0 +1,99 @@
+#include "DGM/classes/PathSearchScheduler.hpp"
+#include "DGM/classes/Error.hpp"
+#include <algorithm>
+#include <string>
+
+using SearchId = dgm::PathSearchScheduler::SearchId;
+
+/**
+ *  Entries are sorted by their ids, returns end iterator if there is no
+ *  entry with given id
+ */
+template<class Entries>
+[[nodiscard]] static auto findEntry(Entries& entries, SearchId id)
+{
+    const auto itr = std::lower_bound(
+        entries.begin(),
+        entries.end(),
+        id,
+        [](const auto& entry, SearchId value) { return entry.id < value; });
+    return itr != entries.end() && itr->id == id ? itr : entries.end();
+}
+
+template<class Entries>
+[[nodiscard]] static auto findExistingEntry(Entries& entries, SearchId id)
+{
+    const auto itr = findEntry(entries, id);
+    if (itr == entries.end())
+        throw dgm::Exception(
+            "There is no path search with id " + std::to_string(id));
+    return itr;
+}
+
+SearchId dgm::PathSearchScheduler::enqueue(TileNavMesh::PathSearch&& search)
+{
+    const SearchId id = nextId++;
+    entries.push_back(Entry { id, std::move(search) });
+    return id;
+}
+
+std::size_t dgm::PathSearchScheduler::update()
+{
+    std::size_t remainingBudget = expansionBudget;
+
+    // Budget is split evenly among the searches in progress. Searches
+    // that finish early leave some budget unused, so it is split again
+    // among the remaining ones until it runs out.
+    while (remainingBudget > 0)
+    {
+        const std::size_t pendingCount = getPendingCount();
+        if (pendingCount == 0) break;
+
+        const std::size_t slice =
+            std::max(remainingBudget / pendingCount, std::size_t { 1 });
+
+        for (std::size_t i = 0; i < entries.size() && remainingBudget > 0;
+             ++i)
+        {
+            const std::size_t index = (nextEntryIndex + i) % entries.size();
+            auto& search = entries[index].search;
+            if (search.isFinished()) continue;
+
+            remainingBudget -= search.step(std::min(slice, remainingBudget));
+            if (remainingBudget == 0) nextEntryIndex = index + 1;
+        }
+    }
+
+    return expansionBudget - remainingBudget;
+}
+
+dgm::PathSearchScheduler::Status
+dgm::PathSearchScheduler::getStatus(SearchId id) const
+{
+    return findExistingEntry(entries, id)->search.getStatus();
+}
+
+std::optional<dgm::Path<dgm::TileNavpoint>>
+dgm::PathSearchScheduler::takePath(SearchId id)
+{
+    const auto itr = findExistingEntry(entries, id);
+    if (!itr->search.isFinished()) return std::nullopt;
+
+    auto&& path = itr->search.getPath();
+    entries.erase(itr);
+    return path;
+}
+
+void dgm::PathSearchScheduler::cancel(SearchId id)
+{
+    const auto itr = findEntry(entries, id);
+    if (itr != entries.end()) entries.erase(itr);
+}
+
+std::size_t dgm::PathSearchScheduler::getPendingCount() const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(
+        entries.begin(),
+        entries.end(),
+        [](const Entry& entry) { return !entry.search.isFinished(); }));
+}
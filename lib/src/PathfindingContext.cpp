@@ -0,0 +1,107 @@
+#include "DGM/classes/PathfindingContext.hpp"
+#include <algorithm>
+
+dgm::PathfindingContext::PathfindingContext(const sf::Vector2u& meshSize)
+{
+    beginSearch(meshSize);
+}
+
+void dgm::PathfindingContext::beginSearch(const sf::Vector2u& meshSize)
+{
+    width = meshSize.x;
+    heap.clear();
+
+    const std::size_t size = std::size_t { meshSize.x } * meshSize.y;
+    if (generations.size() < size)
+    {
+        generations.resize(size, generation);
+        states.resize(size);
+        gcosts.resize(size);
+        parents.resize(size);
+        heapPositions.resize(size);
+    }
+
+    ++generation;
+    if (generation == 0)
+    {
+        // Counter overflowed, stale marks could be mistaken for fresh ones
+        std::fill(generations.begin(), generations.end(), 0);
+        generation = 1;
+    }
+}
+
+bool dgm::PathfindingContext::openNode(
+    IndexType index, unsigned gcost, unsigned hcost, IndexType parent)
+{
+    if (!isVisited(index))
+    {
+        generations[index] = generation;
+        states[index] = NodeState::Open;
+        gcosts[index] = gcost;
+        parents[index] = parent;
+
+        heap.push_back(HeapEntry { gcost + hcost, hcost, index });
+        siftUp(heap.size() - 1);
+        return true;
+    }
+
+    if (states[index] == NodeState::Closed || gcosts[index] < gcost)
+        return false;
+
+    gcosts[index] = gcost;
+    parents[index] = parent;
+
+    const std::size_t position = heapPositions[index];
+    heap[position].fcost = gcost + hcost;
+    siftUp(position);
+    return true;
+}
+
+dgm::PathfindingContext::IndexType dgm::PathfindingContext::popBestNode()
+{
+    const IndexType best = heap.front().index;
+    states[best] = NodeState::Closed;
+
+    const HeapEntry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+    {
+        placeEntry(0, last);
+        siftDown(0);
+    }
+
+    return best;
+}
+
+void dgm::PathfindingContext::siftUp(std::size_t position) noexcept
+{
+    const HeapEntry entry = heap[position];
+    while (position > 0)
+    {
+        const std::size_t parent = (position - 1) / 2;
+        if (!isBetter(entry, heap[parent])) break;
+        placeEntry(position, heap[parent]);
+        position = parent;
+    }
+    placeEntry(position, entry);
+}
+
+void dgm::PathfindingContext::siftDown(std::size_t position) noexcept
+{
+    const HeapEntry entry = heap[position];
+    while (true)
+    {
+        const std::size_t left = position * 2 + 1;
+        const std::size_t right = left + 1;
+        if (left >= heap.size()) break;
+
+        std::size_t child = left;
+        if (right < heap.size() && isBetter(heap[right], heap[left]))
+            child = right;
+        if (!isBetter(heap[child], entry)) break;
+
+        placeEntry(position, heap[child]);
+        position = child;
+    }
+    placeEntry(position, entry);
+}
@@ -13,17 +13,22 @@ bool dgm::Raycaster::hasDirectVisibility(
         to.componentWiseDiv(sf::Vector2f(levelMesh.getVoxelSize()));
 
     auto&& state = initializeRaycaster(normalizedFrom, to - from);
+    const float distance = (normalizedTo - normalizedFrom).length();
 
     HitDirection advancementDirection {};
     while (true)
     {
+        // Ray got past the destination, any tile hit from now on would be
+        // even further away
+        if (getInterceptDistance(state, advancementDirection) > distance)
+            return true;
+
         if (levelMesh[state.tile] > 0) break;
 
         advancementDirection = advanceRaycaster(state);
     }
 
-    return (normalizedTo - normalizedFrom).length()
-           < getInterceptDistance(state, advancementDirection);
+    return distance < getInterceptDistance(state, advancementDirection);
 }
 
 dgm::Raycaster::Result dgm::Raycaster::raycast(
@@ -0,0 +1,79 @@
+#include "DGM/classes/SummedAreaTable.hpp"
+
+dgm::SummedAreaTable::SummedAreaTable(const dgm::Mesh& mesh)
+    : dataSize(mesh.getDataSize())
+    , meshVersion(mesh.getVersion())
+    , sums(std::size_t { dataSize.x + 1 } * (dataSize.y + 1), 0)
+{
+    computeSums(mesh, { 0u, 0u });
+}
+
+void dgm::SummedAreaTable::update(
+    const dgm::Mesh& mesh,
+    const sf::Vector2u& topLeft,
+    const sf::Vector2u& bottomRight)
+{
+    if (mesh.getDataSize() != dataSize)
+    {
+        *this = SummedAreaTable(mesh);
+        return;
+    }
+
+    if (topLeft == bottomRight)
+    {
+        update(mesh, topLeft);
+        return;
+    }
+
+    if (topLeft.x < dataSize.x && topLeft.y < dataSize.y)
+        computeSums(mesh, topLeft);
+    meshVersion = mesh.getVersion();
+}
+
+void dgm::SummedAreaTable::update(
+    const dgm::Mesh& mesh, const sf::Vector2u& tile)
+{
+    if (mesh.getDataSize() != dataSize)
+    {
+        *this = SummedAreaTable(mesh);
+        return;
+    }
+
+    meshVersion = mesh.getVersion();
+    if (tile.x >= dataSize.x || tile.y >= dataSize.y) return;
+
+    const std::uint32_t oldValue = countSolidTiles(tile, tile);
+    const std::uint32_t newValue = mesh[tile] > 0 ? 1u : 0u;
+    if (oldValue == newValue) return;
+
+    // Removing a wall adds -1 by wrapping around. Each row is a plain
+    // loop over contiguous memory, so it gets vectorized.
+    const std::uint32_t delta = newValue - oldValue;
+    const unsigned stride = dataSize.x + 1;
+    for (unsigned y = tile.y + 1; y <= dataSize.y; ++y)
+    {
+        std::uint32_t* row = sums.data() + y * stride;
+        for (unsigned x = tile.x + 1; x <= dataSize.x; ++x)
+            row[x] += delta;
+    }
+}
+
+void dgm::SummedAreaTable::computeSums(
+    const dgm::Mesh& mesh, const sf::Vector2u& topLeft)
+{
+    // Sum of a row prefix is added to the sum of the row above, which keeps
+    // dependencies between iterations down to a single running value
+    const unsigned stride = dataSize.x + 1;
+    for (unsigned y = topLeft.y; y < dataSize.y; ++y)
+    {
+        const std::uint32_t* above = sums.data() + y * stride;
+        std::uint32_t* row = sums.data() + (y + 1) * stride;
+        std::uint32_t rowSum = row[topLeft.x] - above[topLeft.x];
+
+        for (unsigned x = topLeft.x; x < dataSize.x; ++x)
+        {
+            rowSum += mesh[{ x, y }] > 0 ? 1u : 0u;
+            row[x + 1] = above[x + 1] + rowSum;
+        }
+    }
+}
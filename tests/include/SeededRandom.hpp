@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+/**
+ *  Random numbers for generating test meshes and bodies. Sequence depends
+ *  only on the seed, so every run of a test sees the same data.
+ */
+class SeededRandom final
+{
+public:
+    explicit SeededRandom(std::uint32_t seed) : engine(seed) {}
+
+public:
+    /**
+     *  \brief Get number within [0, bound)
+     *
+     *  Distributions of the standard library differ between
+     *  implementations, output of the engine itself does not.
+     */
+    [[nodiscard]] unsigned operator()(unsigned bound)
+    {
+        return static_cast<unsigned>(engine() % bound);
+    }
+
+    /**
+     *  \brief Get true with probability of 1 / n
+     */
+    [[nodiscard]] bool oneIn(unsigned n)
+    {
+        return (*this)(n) == 0u;
+    }
+
+private:
+    std::mt19937 engine;
+};
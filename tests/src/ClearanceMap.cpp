@@ -0,0 +1,263 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/ClearanceMap.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+
+[[nodiscard]] static dgm::Mesh buildMeshForClearanceTesting()
+{
+    // clang-format off
+    const std::vector<int> map = {
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 0, 0, 0, 1, 0, 0, 0, 1,
+        1, 0, 0, 0, 0, 1, 0, 0, 0, 1,
+        1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+        1, 0, 0, 1, 0, 1, 0, 0, 0, 1,
+        1, 0, 0, 1, 1, 1, 0, 0, 0, 1,
+        1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+        1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+    };
+    // clang-format on
+
+    return dgm::Mesh(map, { 10u, 9u }, { 32u, 32u });
+}
+
+[[nodiscard]] static dgm::Mesh buildRandomMesh(std::uint32_t seed)
+{
+    const sf::Vector2u size = { 40u, 30u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(seed);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            mesh[{ x, y }] = random.oneIn(14u) ? 1 : 0;
+        }
+    }
+    return mesh;
+}
+
+/**
+ *  Largest free square at a tile, computed by brute force
+ */
+[[nodiscard]] static unsigned
+getExpectedClearance(const dgm::Mesh& mesh, const sf::Vector2u& tile)
+{
+    const auto size = mesh.getDataSize();
+    unsigned clearance = 0;
+    while (tile.x + clearance < size.x && tile.y + clearance < size.y)
+    {
+        for (unsigned i = 0; i <= clearance; ++i)
+        {
+            if (mesh[{ tile.x + clearance, tile.y + i }] > 0
+                || mesh[{ tile.x + i, tile.y + clearance }] > 0)
+                return clearance;
+        }
+        ++clearance;
+    }
+    return clearance;
+}
+
+static void
+requireExpectedClearance(const dgm::ClearanceMap& map, const dgm::Mesh& mesh)
+{
+    REQUIRE(map.getDataSize() == mesh.getDataSize());
+    for (unsigned y = 0; y < mesh.getDataSize().y; ++y)
+    {
+        for (unsigned x = 0; x < mesh.getDataSize().x; ++x)
+        {
+            REQUIRE(
+                map.getClearance({ x, y })
+                == getExpectedClearance(mesh, { x, y }));
+        }
+    }
+}
+
+TEST_CASE("[ClearanceMap]")
+{
+    auto mesh = buildMeshForClearanceTesting();
+    auto map = dgm::ClearanceMap(mesh);
+
+    SECTION("Clearance is the largest free square at a tile")
+    {
+        REQUIRE(map.getClearance({ 0u, 0u }) == 0u);
+        REQUIRE(map.getClearance({ 1u, 1u }) == 3u);
+        REQUIRE(map.getClearance({ 6u, 1u }) == 3u);
+        REQUIRE(map.getClearance({ 4u, 1u }) == 1u);
+        REQUIRE(map.getClearance({ 1u, 6u }) == 2u);
+        REQUIRE(map.canFit({ 1u, 4u }, 2u));
+        REQUIRE_FALSE(map.canFit({ 2u, 4u }, 2u));
+        requireExpectedClearance(map, mesh);
+    }
+
+    SECTION("Updating a tile only changes tiles above and left of it")
+    {
+        mesh.setTile({ 7u, 6u }, 1);
+        map.update(mesh, { 7u, 6u });
+
+        REQUIRE(map.getMeshVersion() == mesh.getVersion());
+        REQUIRE(map.getClearance({ 6u, 5u }) == 1u);
+        requireExpectedClearance(map, mesh);
+    }
+
+    SECTION("Incremental updates yield the same values as a rebuild")
+    {
+        auto bigMesh = buildRandomMesh(5u);
+        auto bigMap = dgm::ClearanceMap(bigMesh);
+        const auto size = bigMesh.getDataSize();
+
+        auto random = SeededRandom(3u);
+
+        for (unsigned round = 0; round < 50; ++round)
+        {
+            const auto topLeft = sf::Vector2u(random(size.x), random(size.y));
+            const auto bottomRight = sf::Vector2u(
+                std::min(topLeft.x + random(4u), size.x - 1),
+                std::min(topLeft.y + random(4u), size.y - 1));
+            for (unsigned y = topLeft.y; y <= bottomRight.y; ++y)
+            {
+                for (unsigned x = topLeft.x; x <= bottomRight.x; ++x)
+                    bigMesh[{ x, y }] = random(2u) > 0 ? 1 : 0;
+            }
+
+            bigMap.update(bigMesh, topLeft, bottomRight);
+            requireExpectedClearance(bigMap, bigMesh);
+        }
+    }
+}
+
+TEST_CASE("Computing Tile path for large agents", "[ClearanceMap]")
+{
+    using SearchOptions = dgm::TileNavMesh::SearchOptions;
+    using SearchAlgorithm = dgm::TileNavMesh::SearchAlgorithm;
+    using Connectivity = dgm::TileNavMesh::Connectivity;
+
+    SECTION("Large agent avoids narrow passages")
+    {
+        const auto mesh = buildMeshForClearanceTesting();
+        const auto map = dgm::ClearanceMap(mesh);
+
+        const auto small = dgm::TileNavMesh::computePath(
+            { 2u, 1u }, { 7u, 1u }, mesh);
+        const auto large = dgm::TileNavMesh::computePath(
+            { 2u, 1u },
+            { 7u, 1u },
+            mesh,
+            SearchOptions { .agentSize = 2u, .clearance = &map });
+
+        REQUIRE(small);
+        REQUIRE(large);
+        REQUIRE(large->getLength() > small->getLength());
+
+        auto points = large->getPoints();
+        for (auto&& point : points)
+            REQUIRE(map.canFit(point.coord, 2u));
+
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u },
+            { 7u, 1u },
+            mesh,
+            SearchOptions { .agentSize = 4u, .clearance = &map }));
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 7u, 7u },
+            { 1u, 1u },
+            mesh,
+            SearchOptions { .agentSize = 2u, .clearance = &map }));
+    }
+
+    SECTION("Large agent without up to date clearance map is rejected")
+    {
+        // Checked at runtime, so release builds never search large agents
+        // as if they occupied a single tile
+        auto mesh = buildMeshForClearanceTesting();
+        const auto map = dgm::ClearanceMap(mesh);
+        auto cache = dgm::PathCache<dgm::TileNavpoint>();
+        auto context = dgm::PathfindingContext(mesh.getDataSize());
+        const auto targets = std::vector<sf::Vector2u> { { 7u, 1u } };
+
+        auto requireRejected = [&](const SearchOptions& options)
+        {
+            REQUIRE_THROWS_AS(
+                dgm::TileNavMesh::computePath(
+                    { 2u, 1u }, { 7u, 1u }, mesh, options),
+                dgm::Exception);
+            REQUIRE_THROWS_AS(
+                dgm::TileNavMesh::computePath(
+                    { 2u, 1u }, { 7u, 1u }, mesh, cache, options),
+                dgm::Exception);
+            REQUIRE_THROWS_AS(
+                dgm::TileNavMesh::computeDistance(
+                    { 2u, 1u }, { 7u, 1u }, mesh, context, options),
+                dgm::Exception);
+            REQUIRE_THROWS_AS(
+                dgm::TileNavMesh::computeDistances(
+                    { 2u, 1u }, targets, mesh, options),
+                dgm::Exception);
+            REQUIRE_THROWS_AS(
+                dgm::TileNavMesh::PathSearch(
+                    { 2u, 1u }, { 7u, 1u }, mesh, options),
+                dgm::Exception);
+            REQUIRE(cache.getSize() == 0u);
+        };
+
+        requireRejected(SearchOptions { .agentSize = 2u });
+
+        mesh.setTile({ 2u, 3u }, 1);
+        requireRejected(SearchOptions { .agentSize = 2u, .clearance = &map });
+
+        // Clearance map is not needed for agents of a single tile
+        REQUIRE(dgm::TileNavMesh::computePath(
+            { 2u, 1u },
+            { 7u, 1u },
+            mesh,
+            SearchOptions { .agentSize = 1u, .clearance = &map }));
+    }
+
+    SECTION("Paths are as long as on an eroded mesh")
+    {
+        const auto mesh = buildRandomMesh(9u);
+        const auto map = dgm::ClearanceMap(mesh);
+        const auto size = mesh.getDataSize();
+
+        for (unsigned agentSize : { 2u, 3u })
+        {
+            auto eroded = dgm::Mesh(size, mesh.getVoxelSize());
+            for (unsigned y = 0; y < size.y; ++y)
+            {
+                for (unsigned x = 0; x < size.x; ++x)
+                    eroded[{ x, y }] = map.canFit({ x, y }, agentSize) ? 0 : 1;
+            }
+
+            for (auto&& options :
+                 { SearchOptions {},
+                   SearchOptions { .connectivity = Connectivity::EightWay },
+                   SearchOptions {
+                       .algorithm = SearchAlgorithm::JumpPointSearch,
+                       .connectivity = Connectivity::EightWay } })
+            {
+                auto largeOptions = options;
+                largeOptions.agentSize = agentSize;
+                largeOptions.clearance = &map;
+
+                for (unsigned i = 0; i < 20; ++i)
+                {
+                    const auto from = sf::Vector2u(
+                        (i * 7u) % size.x, (i * 5u) % size.y);
+                    const auto to = sf::Vector2u(
+                        size.x - 1 - (i * 3u) % size.x,
+                        size.y - 1 - (i * 11u) % size.y);
+
+                    const auto expected = dgm::TileNavMesh::computePath(
+                        from, to, eroded, options);
+                    const auto actual = dgm::TileNavMesh::computePath(
+                        from, to, mesh, largeOptions);
+
+                    REQUIRE(expected.has_value() == actual.has_value());
+                    if (!expected) continue;
+                    REQUIRE(expected->getLength() == actual->getLength());
+                }
+            }
+        }
+    }
+}
@@ -1,3 +1,4 @@
+#include "SeededRandom.hpp"
 #include <DGM/dgm.hpp>
 #include <catch2/catch_all.hpp>
 
@@ -326,3 +327,399 @@ TEST_CASE("Rect-in-cone", "Collision")
         REQUIRE(dgm::Collision::basic(rect, cone));
     }
 }
+
+TEST_CASE("Batch collisions", "Collision")
+{
+    // Coordinates on a coarse grid, so many shapes touch exactly
+    auto generator = SeededRandom(3u);
+    auto random = [&] { return static_cast<float>(generator(40u)) / 2.f; };
+
+    std::vector<dgm::Circle> circles;
+    std::vector<dgm::Rect> rects;
+    std::vector<float> xs, ys, radii, widths, heights;
+    for (unsigned i = 0; i < 600; ++i)
+    {
+        xs.push_back(random());
+        ys.push_back(random());
+        radii.push_back(random() / 4.f);
+        widths.push_back(random() / 2.f);
+        heights.push_back(random() / 2.f);
+        circles.emplace_back(sf::Vector2f(xs.back(), ys.back()), radii.back());
+        rects.emplace_back(
+            sf::Vector2f(xs.back(), ys.back()),
+            sf::Vector2f(widths.back(), heights.back()));
+    }
+
+    const auto circleBatch = dgm::Collision::CircleBatch {
+        .x = xs, .y = ys, .radius = radii
+    };
+    const auto rectBatch = dgm::Collision::RectBatch {
+        .x = xs, .y = ys, .width = widths, .height = heights
+    };
+
+    auto requireSameAsSingleTests =
+        [](const auto& object, const auto& batch, const auto& others)
+    {
+        std::vector<std::uint64_t> hits(
+            dgm::Collision::getHitMaskSize(others.size()), ~0ull);
+        dgm::Collision::basic(object, batch, hits);
+        auto isHit = [&](std::size_t i)
+        {
+            constexpr auto WORD_BITS = dgm::Collision::HIT_MASK_WORD_BITS;
+            return (hits[i / WORD_BITS] >> (i % WORD_BITS) & 1u) == 1u;
+        };
+
+        std::vector<std::size_t> hitIndices = { 12345u };
+        const std::size_t hitCount =
+            dgm::Collision::collectHits(object, batch, hitIndices);
+        REQUIRE(hitIndices.size() == hitCount + 1u);
+        REQUIRE(hitIndices.front() == 12345u);
+
+        std::vector<std::size_t> expectedIndices = { 12345u };
+        for (std::size_t i = 0; i < others.size(); ++i)
+        {
+            const bool expected = dgm::Collision::basic(object, others[i]);
+            REQUIRE(isHit(i) == expected);
+            if (expected) expectedIndices.push_back(i);
+        }
+
+        // Bits past the end of the batch are cleared
+        for (std::size_t i = others.size(); i < hits.size() * 64u; ++i)
+            REQUIRE_FALSE(isHit(i));
+        REQUIRE(hitIndices == expectedIndices);
+        return hitCount;
+    };
+
+    for (std::size_t i = 0; i < 600; i += 37)
+    {
+        const auto& circle = circles[i];
+        const auto& rect = rects[i];
+
+        REQUIRE(requireSameAsSingleTests(circle, circleBatch, circles) > 0u);
+        REQUIRE(requireSameAsSingleTests(circle, rectBatch, rects) > 0u);
+        REQUIRE(requireSameAsSingleTests(rect, circleBatch, circles) > 0u);
+        REQUIRE(requireSameAsSingleTests(rect, rectBatch, rects) > 0u);
+    }
+
+    SECTION("Empty batch")
+    {
+        std::vector<std::size_t> hitIndices;
+        REQUIRE(
+            dgm::Collision::collectHits(
+                circles.front(), dgm::Collision::CircleBatch {}, hitIndices)
+            == 0u);
+        dgm::Collision::basic(rects.front(), dgm::Collision::RectBatch {}, {});
+    }
+}
+
+/**
+ *  Three probes dgm::Collision::advanced used to do, each scanning the mesh
+ */
+template<class T>
+static bool advanceByProbing(
+    const dgm::Mesh& mesh,
+    T body,
+    sf::Vector2f& forward,
+    std::size_t* meshHitPosition)
+{
+    auto localForward = forward;
+
+    body.move(localForward);
+    if (!dgm::Collision::basic(mesh, body)) return false;
+
+    body.move({ 0.f, -localForward.y });
+    if (!dgm::Collision::basic(mesh, body, meshHitPosition))
+    {
+        forward.y = 0.f;
+        return true;
+    }
+
+    body.move({ -localForward.x, localForward.y });
+    if (!dgm::Collision::basic(mesh, body, meshHitPosition))
+    {
+        forward.x = 0.f;
+        return true;
+    }
+
+    forward = sf::Vector2f(0.f, 0.f);
+    return true;
+}
+
+TEST_CASE("Mesh-contact", "Collision")
+{
+    // Bordered level with random blocks
+    const sf::Vector2u size = { 30u, 20u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(31u);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            mesh[{ x, y }] = border || random(6u) == 0u ? 1 : 0;
+        }
+    }
+
+    SECTION("Advanced gives the same results as probing each axis")
+    {
+        for (unsigned i = 0; i < 2000; ++i)
+        {
+            const auto position = sf::Vector2f(
+                20.f + random(420u) + random(4u) / 4.f, 20.f + random(260u));
+            const auto forward = sf::Vector2f(
+                float(random(41u)) - 20.f, (float(random(41u)) - 20.f) / 3.f);
+
+            auto circleForward = forward, expectedCircleForward = forward;
+            std::size_t circleHit = 0, expectedCircleHit = 0;
+            const auto circle = dgm::Circle(position, 1.f + random(12u));
+            REQUIRE(
+                dgm::Collision::advanced(
+                    mesh, circle, circleForward, &circleHit)
+                == advanceByProbing(
+                    mesh, circle, expectedCircleForward, &expectedCircleHit));
+            REQUIRE(circleForward == expectedCircleForward);
+            REQUIRE(circleHit == expectedCircleHit);
+
+            auto rectForward = forward, expectedRectForward = forward;
+            std::size_t rectHit = 0, expectedRectHit = 0;
+            const auto rect = dgm::Rect(
+                position,
+                sf::Vector2f(1.f + random(20u), 1.f + random(20u)));
+            const bool rectCollided =
+                dgm::Collision::advanced(mesh, rect, rectForward, &rectHit);
+            REQUIRE(
+                rectCollided
+                == advanceByProbing(
+                    mesh, rect, expectedRectForward, &expectedRectHit));
+            REQUIRE(rectForward == expectedRectForward);
+            REQUIRE(rectHit == expectedRectHit);
+
+            const auto contact = dgm::Collision::resolve(mesh, rect, forward);
+            REQUIRE(contact.has_value() == rectCollided);
+            if (!contact) continue;
+
+            REQUIRE(contact->forward == rectForward);
+            REQUIRE((contact->blockedX || contact->blockedY));
+            REQUIRE(contact->penetration >= 0.f);
+            REQUIRE(contact->normal.lengthSquared() == 1.f);
+        }
+    }
+
+    SECTION("Contact with a wall")
+    {
+        // clang-format off
+        const auto room = dgm::Mesh(
+            std::vector<int> {
+                0, 0, 0, 1,
+                0, 0, 0, 1,
+                1, 1, 1, 1,
+            },
+            { 4u, 3u },
+            { 10u, 10u });
+        // clang-format on
+
+        const auto contact = dgm::Collision::resolve(
+            room, dgm::Rect({ 2.f, 2.f }, { 5.f, 5.f }), { 26.f, 1.f });
+        REQUIRE(contact);
+        REQUIRE(contact->blockedX);
+        REQUIRE_FALSE(contact->blockedY);
+        REQUIRE(contact->forward == sf::Vector2f(0.f, 1.f));
+        REQUIRE(contact->penetration == 3.f);
+        REQUIRE(contact->normal == sf::Vector2f(-1.f, 0.f));
+        REQUIRE(contact->meshHitPosition == 3u);
+
+        const auto floorContact = dgm::Collision::resolve(
+            room, dgm::Circle({ 15.f, 14.f }, 4.f), { 0.f, 4.f });
+        REQUIRE(floorContact);
+        REQUIRE(floorContact->blockedY);
+        REQUIRE(floorContact->forward == sf::Vector2f(0.f, 0.f));
+        REQUIRE(floorContact->normal == sf::Vector2f(0.f, -1.f));
+        REQUIRE(floorContact->penetration == 2.f);
+
+        REQUIRE_FALSE(dgm::Collision::resolve(
+            room, dgm::Circle({ 15.f, 10.f }, 4.f), { -3.f, 0.f }));
+    }
+}
+
+/**
+ *  Whether a body overlaps any impassable tile, touching does not count
+ */
+[[nodiscard]] static bool
+overlapsWall(const dgm::Mesh& mesh, const dgm::Rect& body)
+{
+    for (unsigned y = 0; y < mesh.getDataSize().y; ++y)
+    {
+        for (unsigned x = 0; x < mesh.getDataSize().x; ++x)
+        {
+            if (mesh[{ x, y }] <= 0) continue;
+            const auto tileMin = sf::Vector2f(
+                float(x * mesh.getVoxelSize().x),
+                float(y * mesh.getVoxelSize().y));
+            const auto tileMax = tileMin + sf::Vector2f(mesh.getVoxelSize());
+            const auto bodyMin = body.getPosition();
+            const auto bodyMax = bodyMin + body.getSize();
+            if (bodyMin.x < tileMax.x && tileMin.x < bodyMax.x
+                && bodyMin.y < tileMax.y && tileMin.y < bodyMax.y)
+                return true;
+        }
+    }
+    return false;
+}
+
+[[nodiscard]] static bool
+overlapsWall(const dgm::Mesh& mesh, const dgm::Circle& body)
+{
+    for (unsigned y = 0; y < mesh.getDataSize().y; ++y)
+    {
+        for (unsigned x = 0; x < mesh.getDataSize().x; ++x)
+        {
+            if (mesh[{ x, y }] <= 0) continue;
+            const auto tile = dgm::Rect(
+                sf::Vector2f(
+                    float(x * mesh.getVoxelSize().x),
+                    float(y * mesh.getVoxelSize().y)),
+                sf::Vector2f(mesh.getVoxelSize()));
+            if (dgm::Collision::basic(tile, body)) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ *  Moves the body in many small steps and returns the fraction of forward
+ *  at which it first overlaps a wall
+ */
+template<class T>
+[[nodiscard]] static std::optional<float> sweepBySubstepping(
+    const dgm::Mesh& mesh, const T& body, const sf::Vector2f& forward)
+{
+    constexpr unsigned STEP_COUNT = 1000;
+    for (unsigned i = 0; i <= STEP_COUNT; ++i)
+    {
+        const float time = float(i) / STEP_COUNT;
+        auto moved = body;
+        moved.move(forward * time);
+        if (overlapsWall(mesh, moved)) return time;
+    }
+    return std::nullopt;
+}
+
+TEST_CASE("Mesh-sweep", "Collision")
+{
+    // clang-format off
+    const auto mesh = dgm::Mesh(
+        std::vector<int> {
+            0, 0, 0, 0, 0, 1, 0, 0,
+            0, 0, 0, 0, 0, 1, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 1, 0, 0, 0, 0, 0,
+        },
+        { 8u, 4u },
+        { 10u, 10u });
+    // clang-format on
+
+    SECTION("Fast body does not pass through a thin wall")
+    {
+        const auto rect = dgm::Rect({ 10.f, 2.f }, { 4.f, 4.f });
+        auto forward = sf::Vector2f(60.f, 0.f);
+        REQUIRE_FALSE(dgm::Collision::advanced(mesh, rect, forward));
+
+        const auto hit = dgm::Collision::sweep(mesh, rect, forward);
+        REQUIRE(hit);
+        REQUIRE_THAT(hit->time, Catch::Matchers::WithinAbs(0.6f, 0.0001f));
+        REQUIRE(hit->normal == sf::Vector2f(-1.f, 0.f));
+        REQUIRE(hit->meshHitPosition == 5u);
+    }
+
+    SECTION("Circle hits corner of a tile")
+    {
+        const auto circle = dgm::Circle({ 10.f, 20.f }, 2.f);
+        const auto hit =
+            dgm::Collision::sweep(mesh, circle, { 20.f, 20.f });
+        REQUIRE(hit);
+
+        const float expectedTime = (10.f - 2.f / std::sqrt(2.f)) / 20.f;
+        REQUIRE_THAT(
+            hit->time, Catch::Matchers::WithinAbs(expectedTime, 0.0001f));
+        REQUIRE_THAT(
+            hit->normal.x,
+            Catch::Matchers::WithinAbs(-1.f / std::sqrt(2.f), 0.0001f));
+        REQUIRE_THAT(
+            hit->normal.y,
+            Catch::Matchers::WithinAbs(-1.f / std::sqrt(2.f), 0.0001f));
+        REQUIRE(hit->meshHitPosition == 26u);
+    }
+
+    SECTION("Body touching a wall slides along it")
+    {
+        const auto rect = dgm::Rect({ 40.f, 0.f }, { 10.f, 10.f });
+        REQUIRE_FALSE(dgm::Collision::sweep(mesh, rect, { 0.f, 15.f }));
+        REQUIRE_FALSE(dgm::Collision::sweep(mesh, rect, { -20.f, 0.f }));
+
+        const auto hit = dgm::Collision::sweep(mesh, rect, { 5.f, 5.f });
+        REQUIRE(hit);
+        REQUIRE(hit->time == 0.f);
+        REQUIRE(hit->normal == sf::Vector2f(-1.f, 0.f));
+    }
+
+    SECTION("Body overlapping a wall from the start")
+    {
+        const auto hit = dgm::Collision::sweep(
+            mesh, dgm::Circle({ 25.f, 35.f }, 3.f), { 10.f, 0.f });
+        REQUIRE(hit);
+        REQUIRE(hit->time == 0.f);
+        REQUIRE(hit->normal == sf::Vector2f());
+        REQUIRE(hit->meshHitPosition == 26u);
+    }
+
+    SECTION("Body outside of the mesh")
+    {
+        REQUIRE_FALSE(dgm::Collision::sweep(
+            mesh, dgm::Rect({ -50.f, -20.f }, { 5.f, 5.f }), { 200.f, 0.f }));
+
+        const auto hit = dgm::Collision::sweep(
+            mesh, dgm::Rect({ -50.f, 2.f }, { 5.f, 5.f }), { 200.f, 0.f });
+        REQUIRE(hit);
+        REQUIRE(hit->meshHitPosition == 5u);
+    }
+
+    SECTION("Matches moving the body in small steps")
+    {
+        auto random = SeededRandom(7u);
+
+        auto requireMatch = [&](const auto& body, const sf::Vector2f& forward)
+        {
+            const auto hit = dgm::Collision::sweep(mesh, body, forward);
+            const auto expected = sweepBySubstepping(mesh, body, forward);
+            if (!expected)
+            {
+                // Hit in between the last two steps or a graze
+                REQUIRE((!hit || hit->time > 0.998f || hit->time == 0.f));
+                return;
+            }
+
+            REQUIRE(hit);
+            REQUIRE(hit->time <= *expected + 0.0001f);
+            REQUIRE(hit->time >= *expected - 0.0011f);
+        };
+
+        for (unsigned i = 0; i < 300; ++i)
+        {
+            const auto position = sf::Vector2f(
+                random(800u) / 10.f - 5.f, random(400u) / 10.f - 5.f);
+            const auto forward = sf::Vector2f(
+                random(1200u) / 10.f - 60.f, random(600u) / 10.f - 30.f);
+
+            requireMatch(
+                dgm::Circle(position, 0.5f + random(60u) / 10.f), forward);
+            requireMatch(
+                dgm::Rect(
+                    position,
+                    sf::Vector2f(
+                        0.5f + random(120u) / 10.f,
+                        0.5f + random(120u) / 10.f)),
+                forward);
+        }
+    }
+}
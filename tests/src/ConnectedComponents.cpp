@@ -0,0 +1,182 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/ConnectedComponents.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <unordered_map>
+
+[[nodiscard]] static dgm::Mesh buildMeshForComponentTesting()
+{
+    // clang-format off
+    const std::vector<int> map = {
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 0, 0, 1, 0, 0, 1, 0, 1,
+        1, 0, 1, 0, 1, 0, 0, 1, 0, 1,
+        1, 0, 0, 0, 1, 0, 1, 0, 0, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+    };
+    // clang-format on
+
+    return dgm::Mesh(map, { 10u, 5u }, { 32u, 32u });
+}
+
+/**
+ *  Both labelings must split the passable tiles into the same groups
+ */
+static void requireSamePartition(
+    const dgm::ConnectedComponents& actual,
+    const dgm::ConnectedComponents& expected)
+{
+    using ComponentId = dgm::ConnectedComponents::ComponentId;
+
+    REQUIRE(actual.getDataSize() == expected.getDataSize());
+    std::unordered_map<ComponentId, ComponentId> expectedToActual;
+    std::unordered_map<ComponentId, ComponentId> actualToExpected;
+    for (unsigned y = 0; y < actual.getDataSize().y; ++y)
+    {
+        for (unsigned x = 0; x < actual.getDataSize().x; ++x)
+        {
+            const auto a = actual.getComponent({ x, y });
+            const auto e = expected.getComponent({ x, y });
+            REQUIRE(
+                (a == dgm::ConnectedComponents::NO_COMPONENT)
+                == (e == dgm::ConnectedComponents::NO_COMPONENT));
+
+            REQUIRE(expectedToActual.emplace(e, a).first->second == a);
+            REQUIRE(actualToExpected.emplace(a, e).first->second == e);
+        }
+    }
+}
+
+TEST_CASE("[ConnectedComponents]")
+{
+    auto mesh = buildMeshForComponentTesting();
+    auto components = dgm::ConnectedComponents(mesh);
+
+    SECTION("Tiles are grouped by four-way connectivity")
+    {
+        REQUIRE(components.areConnected({ 1u, 1u }, { 3u, 3u }));
+        REQUIRE(components.areConnected({ 5u, 1u }, { 5u, 3u }));
+        REQUIRE(components.areConnected({ 8u, 1u }, { 7u, 3u }));
+
+        REQUIRE_FALSE(components.areConnected({ 1u, 1u }, { 5u, 1u }));
+
+        // Only diagonal neighbors, navmeshes never cut corners
+        REQUIRE_FALSE(components.areConnected({ 5u, 3u }, { 7u, 3u }));
+    }
+
+    SECTION("Walls have no component")
+    {
+        REQUIRE(
+            components.getComponent({ 2u, 2u })
+            == dgm::ConnectedComponents::NO_COMPONENT);
+        REQUIRE_FALSE(components.areConnected({ 2u, 2u }, { 2u, 2u }));
+        REQUIRE(components.areConnected({ 1u, 1u }, { 1u, 1u }));
+    }
+
+    SECTION("Opening a wall merges components")
+    {
+        mesh.setTile({ 4u, 2u }, 0);
+        components.update(mesh, { 4u, 2u });
+
+        REQUIRE(components.areConnected({ 1u, 1u }, { 5u, 1u }));
+        REQUIRE(components.getMeshVersion() == mesh.getVersion());
+        requireSamePartition(components, dgm::ConnectedComponents(mesh));
+    }
+
+    SECTION("Placing a wall splits a component")
+    {
+        mesh.setTile({ 1u, 2u }, 1);
+        mesh.setTile({ 3u, 2u }, 1);
+        components.update(mesh, { 1u, 2u }, { 3u, 2u });
+
+        REQUIRE_FALSE(components.areConnected({ 1u, 1u }, { 1u, 3u }));
+        requireSamePartition(components, dgm::ConnectedComponents(mesh));
+    }
+
+    SECTION("Incremental updates yield the same components as a rebuild")
+    {
+        const sf::Vector2u size = { 40u, 30u };
+        auto bigMesh = dgm::Mesh(size, { 16u, 16u });
+        auto bigComponents = dgm::ConnectedComponents(bigMesh);
+
+        auto random = SeededRandom(11u);
+
+        for (unsigned round = 0; round < 200; ++round)
+        {
+            // Mostly walls, so the components keep splitting and merging
+            const auto topLeft = sf::Vector2u(random(size.x), random(size.y));
+            const auto bottomRight = sf::Vector2u(
+                std::min(topLeft.x + random(3u), size.x - 1),
+                std::min(topLeft.y + random(3u), size.y - 1));
+            for (unsigned y = topLeft.y; y <= bottomRight.y; ++y)
+            {
+                for (unsigned x = topLeft.x; x <= bottomRight.x; ++x)
+                    bigMesh[{ x, y }] = random(3u) > 0 ? 1 : 0;
+            }
+
+            bigComponents.update(bigMesh, topLeft, bottomRight);
+            requireSamePartition(
+                bigComponents, dgm::ConnectedComponents(bigMesh));
+        }
+    }
+}
+
+TEST_CASE("Rejecting unreachable destinations", "[ConnectedComponents]")
+{
+    using Status = dgm::TileNavMesh::PathSearch::Status;
+
+    auto mesh = buildMeshForComponentTesting();
+    const auto components = dgm::ConnectedComponents(mesh);
+    const auto options =
+        dgm::TileNavMesh::SearchOptions { .components = &components };
+
+    SECTION("TileNavMesh")
+    {
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, options));
+        REQUIRE(
+            dgm::TileNavMesh::computePath({ 1u, 1u }, { 3u, 3u }, mesh, options)
+                ->getLength()
+            == 4u);
+
+        auto search =
+            dgm::TileNavMesh::PathSearch({ 1u, 1u }, { 8u, 1u }, mesh, options);
+        REQUIRE(search.getStatus() == Status::Unreachable);
+        REQUIRE(search.getExpandedNodeCount() == 0u);
+    }
+
+    SECTION("Stale components are ignored")
+    {
+        // Checked at runtime, so release builds don't reject destinations
+        // that became reachable after an edit
+        mesh.setTile({ 4u, 2u }, 0);
+        mesh.setTile({ 7u, 2u }, 0);
+
+        REQUIRE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, options));
+        REQUIRE(dgm::TileNavMesh::computeDistance(
+            { 1u, 1u }, { 8u, 1u }, mesh, options));
+
+        const auto targets = std::vector<sf::Vector2u> { { 8u, 1u } };
+        REQUIRE(dgm::TileNavMesh::computeDistances(
+            { 1u, 1u }, targets, mesh, options)[0]);
+
+        auto search =
+            dgm::TileNavMesh::PathSearch({ 1u, 1u }, { 8u, 1u }, mesh, options);
+        search.step(1000u);
+        REQUIRE(search.getStatus() == Status::Found);
+    }
+
+    SECTION("WorldNavMesh keeps its components up to date")
+    {
+        auto navmesh = dgm::WorldNavMesh(mesh.clone());
+        const auto from = sf::Vector2f(48.f, 48.f);
+        const auto to = sf::Vector2f(272.f, 48.f);
+        REQUIRE(navmesh.computePath(from, to).isTraversed());
+
+        navmesh.setTile({ 4u, 2u }, 0);
+        navmesh.setTile({ 7u, 2u }, 0);
+        navmesh.applyChanges();
+        REQUIRE_FALSE(navmesh.computePath(from, to).isTraversed());
+    }
+}
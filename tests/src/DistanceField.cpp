@@ -0,0 +1,156 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/DistanceField.hpp>
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <limits>
+
+[[nodiscard]] static dgm::Mesh buildMeshForDistanceTesting()
+{
+    // Non-square voxels, so both axes are scaled differently
+    const sf::Vector2u size = { 37u, 23u };
+    auto mesh = dgm::Mesh(size, { 8u, 12u });
+    auto random = SeededRandom(13u);
+    for (auto&& tile : mesh.getRawData())
+        tile = random.oneIn(7u) ? 1 : 0;
+    mesh.setPosition({ -40.f, 16.f });
+    return mesh;
+}
+
+/**
+ *  Brute force distance between tile centers, shifted the same way as
+ *  dgm::DistanceField shifts them
+ */
+[[nodiscard]] static float
+computeReferenceDistance(const dgm::Mesh& mesh, const sf::Vector2u& tile)
+{
+    const auto voxelSize = sf::Vector2f(mesh.getVoxelSize());
+    const bool isWall = mesh[tile] > 0;
+
+    float nearest = std::numeric_limits<float>::max();
+    for (unsigned y = 0; y < mesh.getDataSize().y; ++y)
+    {
+        for (unsigned x = 0; x < mesh.getDataSize().x; ++x)
+        {
+            if ((mesh[{ x, y }] > 0) == isWall) continue;
+            const float dX = (float(x) - float(tile.x)) * voxelSize.x;
+            const float dY = (float(y) - float(tile.y)) * voxelSize.y;
+            nearest = std::min(nearest, std::sqrt(dX * dX + dY * dY));
+        }
+    }
+
+    const float halfTile = std::min(voxelSize.x, voxelSize.y) / 2.f;
+    return isWall ? halfTile - nearest : nearest - halfTile;
+}
+
+TEST_CASE("[DistanceField]")
+{
+    const auto mesh = buildMeshForDistanceTesting();
+    const auto field = dgm::DistanceField(mesh, 1u);
+    const auto size = mesh.getDataSize();
+
+    auto tileCenter = [&](unsigned x, unsigned y)
+    {
+        return mesh.getPosition()
+               + sf::Vector2f(
+                   (x + 0.5f) * mesh.getVoxelSize().x,
+                   (y + 0.5f) * mesh.getVoxelSize().y);
+    };
+
+    SECTION("Distances match brute force")
+    {
+        for (unsigned y = 0; y < size.y; ++y)
+        {
+            for (unsigned x = 0; x < size.x; ++x)
+            {
+                const float expected = computeReferenceDistance(mesh, { x, y });
+                REQUIRE_THAT(
+                    field.getDistance({ x, y }),
+                    Catch::Matchers::WithinAbs(expected, 0.001f));
+                REQUIRE(
+                    (field.getDistance({ x, y }) < 0.f)
+                    == (mesh[{ x, y }] > 0));
+            }
+        }
+    }
+
+    SECTION("Result does not depend on number of threads")
+    {
+        for (unsigned threadCount : { 0u, 2u, 3u, 16u })
+        {
+            const auto parallelField = dgm::DistanceField(mesh, threadCount);
+            for (unsigned y = 0; y < size.y; ++y)
+            {
+                for (unsigned x = 0; x < size.x; ++x)
+                    REQUIRE(
+                        parallelField.getDistance({ x, y })
+                        == field.getDistance({ x, y }));
+            }
+        }
+    }
+
+    SECTION("Sampling interpolates between tile centers")
+    {
+        REQUIRE(
+            field.sample(tileCenter(3u, 4u))
+            == field.getDistance({ 3u, 4u }));
+
+        const auto between = (tileCenter(3u, 4u) + tileCenter(4u, 5u)) / 2.f;
+        const float average =
+            (field.getDistance({ 3u, 4u }) + field.getDistance({ 4u, 4u })
+             + field.getDistance({ 3u, 5u }) + field.getDistance({ 4u, 5u }))
+            / 4.f;
+        REQUIRE_THAT(
+            field.sample(between),
+            Catch::Matchers::WithinAbs(average, 0.001f));
+
+        // Points outside of the mesh are clamped to its edge
+        REQUIRE(
+            field.sample(mesh.getPosition() - sf::Vector2f(100.f, 100.f))
+            == field.getDistance({ 0u, 0u }));
+        REQUIRE(
+            field.sample(tileCenter(size.x + 5u, size.y + 5u))
+            == field.getDistance(size - sf::Vector2u(1u, 1u)));
+    }
+}
+
+TEST_CASE("Steering with DistanceField", "[DistanceField]")
+{
+    // clang-format off
+    const std::vector<int> map = {
+        0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 1, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0,
+    };
+    // clang-format on
+    const auto mesh = dgm::Mesh(map, { 7u, 5u }, { 10u, 10u });
+    const auto field = dgm::DistanceField(mesh);
+
+    SECTION("Gradient points away from the wall")
+    {
+        const auto right = field.getGradient({ 55.f, 25.f });
+        REQUIRE(right.x > 0.9f);
+        REQUIRE(std::abs(right.y) < 0.001f);
+
+        const auto above = field.getGradient({ 35.f, 15.f });
+        REQUIRE(above.y < -0.9f);
+        REQUIRE(std::abs(above.x) < 0.001f);
+    }
+
+    SECTION("Circle collides when it reaches the wall")
+    {
+        REQUIRE(field.getDistance({ 4u, 2u }) == 5.f);
+        REQUIRE(field.collides(dgm::Circle({ 45.f, 25.f }, 6.f)));
+        REQUIRE_FALSE(field.collides(dgm::Circle({ 45.f, 25.f }, 4.f)));
+        REQUIRE_FALSE(field.collides(dgm::Circle({ 5.f, 5.f }, 10.f)));
+    }
+
+    SECTION("Mesh without walls")
+    {
+        const auto emptyField =
+            dgm::DistanceField(dgm::Mesh({ 3u, 4u }, { 10u, 10u }));
+        REQUIRE(emptyField.getDistance({ 1u, 1u }) == 50.f);
+        REQUIRE(emptyField.getGradient({ 15.f, 15.f }) == sf::Vector2f());
+    }
+}
@@ -0,0 +1,280 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/FlowField.hpp>
+#include <catch2/catch_all.hpp>
+#include <deque>
+#include <limits>
+
+[[nodiscard]] static dgm::Mesh buildMeshForFlowFieldTesting()
+{
+    // Bordered 80x72 map with walls that have gaps, some random noise
+    // generated from a fixed seed and one isolated room
+    const sf::Vector2u size = { 80u, 72u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(1337u);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            const bool wall = x % 16 == 8 && y % 24 != 5;
+            const bool room = (x == 70 || y == 60) && x >= 70 && y >= 60;
+            const bool noise = random.oneIn(7u);
+            mesh[{ x, y }] = border || wall || room || noise ? 1 : 0;
+        }
+    }
+    mesh[{ 75u, 65u }] = 0;
+    return mesh;
+}
+
+/**
+ *  Reference breadth-first search from goal over 4-connected neighborhood
+ */
+[[nodiscard]] static std::vector<unsigned>
+computeBfsDistances(const sf::Vector2u& goal, const dgm::Mesh& mesh)
+{
+    const auto width = mesh.getDataSize().x;
+    auto distances = std::vector<unsigned>(
+        mesh.getRawConstData().size(), std::numeric_limits<unsigned>::max());
+    auto queue = std::deque<sf::Vector2u> { goal };
+    distances[goal.y * width + goal.x] = 0;
+
+    while (!queue.empty())
+    {
+        const auto point = queue.front();
+        queue.pop_front();
+
+        for (auto&& next : { sf::Vector2u(point.x, point.y - 1),
+                             sf::Vector2u(point.x, point.y + 1),
+                             sf::Vector2u(point.x - 1, point.y),
+                             sf::Vector2u(point.x + 1, point.y) })
+        {
+            const auto index = next.y * width + next.x;
+            if (mesh[next] > 0
+                || distances[index] != std::numeric_limits<unsigned>::max())
+                continue;
+            distances[index] = distances[point.y * width + point.x] + 1;
+            queue.push_back(next);
+        }
+    }
+
+    return distances;
+}
+
+/**
+ *  Every reachable tile, except for goals, must point to a passable
+ *  neighbor which is closer to the goal by exactly the cost of the step
+ */
+static void requireConsistentDirections(
+    const dgm::FlowField& field, const dgm::Mesh& mesh)
+{
+    const auto size = field.getDataSize();
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const auto tile = sf::Vector2u(x, y);
+            const auto direction = field.getDirection(tile);
+            if (!field.isReachable(tile) || field.getDistance(tile) == 0)
+            {
+                REQUIRE(direction == sf::Vector2i(0, 0));
+                continue;
+            }
+
+            REQUIRE(direction != sf::Vector2i(0, 0));
+            const auto next = sf::Vector2u(sf::Vector2i(tile) + direction);
+            REQUIRE(mesh[next] <= 0);
+            const unsigned cost = direction.x != 0 && direction.y != 0
+                                      ? dgm::FlowField::DIAGONAL_COST
+                                      : dgm::FlowField::STRAIGHT_COST;
+            REQUIRE(field.getDistance(next) + cost == field.getDistance(tile));
+        }
+    }
+}
+
+TEST_CASE("[FlowField]")
+{
+    using Connectivity = dgm::FlowField::Connectivity;
+
+    const auto mesh = buildMeshForFlowFieldTesting();
+    const auto size = mesh.getDataSize();
+    const auto goal = sf::Vector2u(3u, 3u);
+    auto field = dgm::FlowField();
+
+    SECTION("Four-way distances are equal to BFS distances")
+    {
+        field.compute(mesh, goal);
+        const auto reference = computeBfsDistances(goal, mesh);
+
+        for (unsigned y = 0; y < size.y; ++y)
+        {
+            for (unsigned x = 0; x < size.x; ++x)
+            {
+                const auto expected = reference[y * size.x + x];
+                if (expected == std::numeric_limits<unsigned>::max())
+                    REQUIRE_FALSE(field.isReachable({ x, y }));
+                else
+                    REQUIRE(
+                        field.getDistance({ x, y })
+                        == expected * dgm::FlowField::STRAIGHT_COST);
+            }
+        }
+
+        requireConsistentDirections(field, mesh);
+    }
+
+    SECTION("Eight-way distances are equal to costs of eight-way paths")
+    {
+        field.compute(mesh, goal, Connectivity::EightWay);
+        requireConsistentDirections(field, mesh);
+
+        for (unsigned i = 0; i < 30; ++i)
+        {
+            const auto from = sf::Vector2u(
+                1u + (i * 17u) % (size.x - 2u), 1u + (i * 11u) % (size.y - 2u));
+            if (mesh[from] > 0) continue;
+
+            const auto path = dgm::TileNavMesh::computePath(
+                from,
+                goal,
+                mesh,
+                { .connectivity = Connectivity::EightWay });
+            REQUIRE(path.has_value() == field.isReachable(from));
+            if (!path) continue;
+
+            // Following the field takes the same number of steps
+            auto tile = from;
+            std::size_t steps = 0;
+            while (tile != goal)
+            {
+                tile = sf::Vector2u(
+                    sf::Vector2i(tile) + field.getDirection(tile));
+                ++steps;
+            }
+            REQUIRE(steps <= path->getLength());
+        }
+    }
+
+    SECTION("Isolated room is unreachable")
+    {
+        field.compute(mesh, goal);
+        REQUIRE_FALSE(field.isReachable({ 75u, 65u }));
+        REQUIRE(field.getDirection({ 75u, 65u }) == sf::Vector2i(0, 0));
+        REQUIRE(field.getDistance(goal) == 0u);
+        REQUIRE(field.getDirection(goal) == sf::Vector2i(0, 0));
+    }
+
+    SECTION("Impassable goals are ignored")
+    {
+        field.compute(mesh, sf::Vector2u(0u, 0u));
+        REQUIRE_FALSE(field.isReachable({ 3u, 3u }));
+    }
+
+    SECTION("Multithreaded computation yields the same field")
+    {
+        // Wavefront has to be large enough to be actually split
+        auto largeMesh = dgm::Mesh({ 512u, 512u }, { 16u, 16u });
+        for (unsigned y = 0; y < 512u; ++y)
+        {
+            for (unsigned x = 0; x < 512u; ++x)
+                largeMesh[{ x, y }] = (x * 7u + y * 13u) % 29u == 0 ? 1 : 0;
+        }
+
+        for (auto&& connectivity :
+             { Connectivity::FourWay, Connectivity::EightWay })
+        {
+            auto parallelField = dgm::FlowField();
+            field.compute(largeMesh, { 256u, 255u }, connectivity, 1);
+            parallelField.compute(largeMesh, { 256u, 255u }, connectivity, 4);
+
+            std::size_t mismatchCount = 0;
+            for (unsigned y = 0; y < 512u; ++y)
+            {
+                for (unsigned x = 0; x < 512u; ++x)
+                {
+                    mismatchCount += field.getDistance({ x, y })
+                                         != parallelField.getDistance({ x, y })
+                                     || field.getDirection({ x, y })
+                                            != parallelField.getDirection(
+                                                { x, y });
+                }
+            }
+
+            REQUIRE(field.isReachable({ 511u, 511u }));
+            REQUIRE(mismatchCount == 0u);
+        }
+    }
+
+    SECTION("Adding goals is the same as computing with all of them")
+    {
+        const std::vector<sf::Vector2u> goals = {
+            goal, { 60u, 40u }, { 20u, 66u }
+        };
+
+        for (auto&& connectivity :
+             { Connectivity::FourWay, Connectivity::EightWay })
+        {
+            auto reference = dgm::FlowField();
+            reference.compute(mesh, goals, connectivity);
+
+            field.compute(mesh, goal, connectivity);
+            field.addGoals(mesh, std::span(goals).subspan(1));
+
+            for (unsigned y = 0; y < size.y; ++y)
+            {
+                for (unsigned x = 0; x < size.x; ++x)
+                {
+                    REQUIRE(
+                        field.getDistance({ x, y })
+                        == reference.getDistance({ x, y }));
+                }
+            }
+
+            requireConsistentDirections(field, mesh);
+        }
+    }
+
+    SECTION("Removing goals is the same as computing without them")
+    {
+        const std::vector<sf::Vector2u> goals = {
+            goal, { 60u, 40u }, { 20u, 66u }, { 40u, 10u }
+        };
+
+        for (auto&& connectivity :
+             { Connectivity::FourWay, Connectivity::EightWay })
+        {
+            field.compute(mesh, goals, connectivity);
+
+            for (std::size_t removedCount = 1; removedCount < goals.size();
+                 ++removedCount)
+            {
+                auto reference = dgm::FlowField();
+                reference.compute(
+                    mesh, std::span(goals).subspan(removedCount), connectivity);
+
+                // Tiles that are not goals are ignored
+                const auto removed = std::vector<sf::Vector2u> {
+                    goals[removedCount - 1], { 50u, 50u }, { 0u, 0u }
+                };
+                field.removeGoals(mesh, removed);
+
+                for (unsigned y = 0; y < size.y; ++y)
+                {
+                    for (unsigned x = 0; x < size.x; ++x)
+                    {
+                        REQUIRE(
+                            field.getDistance({ x, y })
+                            == reference.getDistance({ x, y }));
+                        REQUIRE(
+                            field.getDirection({ x, y })
+                            == reference.getDirection({ x, y }));
+                    }
+                }
+            }
+
+            field.removeGoals(mesh, std::span(goals).last(1));
+            REQUIRE_FALSE(field.isReachable(goal));
+            requireConsistentDirections(field, mesh);
+        }
+    }
+}
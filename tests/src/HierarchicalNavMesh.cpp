@@ -0,0 +1,188 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/Error.hpp>
+#include <DGM/classes/HierarchicalNavMesh.hpp>
+#include <catch2/catch_all.hpp>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+
+[[nodiscard]] static dgm::Mesh buildMazeForHierarchicalTesting()
+{
+    // Bordered 96x80 map with long walls that have a few gaps and random
+    // noise generated from a fixed seed, so the test is deterministic
+    const sf::Vector2u size = { 96u, 80u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(42u);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            const bool wall = x % 20 == 10 && y % 25 != 3;
+            const bool noise = random.oneIn(6u);
+            mesh[{ x, y }] = border || wall || noise ? 1 : 0;
+        }
+    }
+    return mesh;
+}
+
+[[nodiscard]] static std::optional<unsigned> computeBfsDistance(
+    const sf::Vector2u& from, const sf::Vector2u& to, const dgm::Mesh& mesh)
+{
+    const auto width = mesh.getDataSize().x;
+    auto distances = std::vector<unsigned>(
+        mesh.getRawConstData().size(), std::numeric_limits<unsigned>::max());
+    auto queue = std::deque<sf::Vector2u> { from };
+    distances[from.y * width + from.x] = 0;
+
+    while (!queue.empty())
+    {
+        const auto point = queue.front();
+        queue.pop_front();
+        if (point == to) return distances[point.y * width + point.x];
+
+        for (auto&& next : { sf::Vector2u(point.x, point.y - 1),
+                             sf::Vector2u(point.x, point.y + 1),
+                             sf::Vector2u(point.x - 1, point.y),
+                             sf::Vector2u(point.x + 1, point.y) })
+        {
+            const auto index = next.y * width + next.x;
+            if (mesh[next] > 0
+                || distances[index] != std::numeric_limits<unsigned>::max())
+                continue;
+            distances[index] = distances[point.y * width + point.x] + 1;
+            queue.push_back(next);
+        }
+    }
+
+    return std::nullopt;
+}
+
+static void requireValidTilePath(
+    const sf::Vector2u& from,
+    const sf::Vector2u& to,
+    dgm::Path<dgm::TileNavpoint> path,
+    const dgm::Mesh& mesh)
+{
+    auto previous = from;
+    while (!path.isTraversed())
+    {
+        const auto point = path.getCurrentPoint().coord;
+        REQUIRE(
+            std::abs(int(point.x) - int(previous.x))
+                + std::abs(int(point.y) - int(previous.y))
+            == 1);
+        REQUIRE(mesh[point] <= 0);
+        previous = point;
+        path.advance();
+    }
+    REQUIRE(previous == to);
+}
+
+TEST_CASE("[HierarchicalNavMesh]")
+{
+    const auto mesh = buildMazeForHierarchicalTesting();
+    const auto navmesh = dgm::HierarchicalNavMesh(mesh.clone(), 8u);
+    auto context = dgm::PathfindingContext();
+
+    auto forEachQuery = [&](auto&& callback)
+    {
+        const auto size = mesh.getDataSize();
+        for (unsigned i = 0; i < 60; ++i)
+        {
+            const auto from = sf::Vector2u(
+                1u + (i * 7u) % (size.x - 2u), 1u + (i * 13u) % (size.y - 2u));
+            const auto to = sf::Vector2u(
+                size.x - 2u - (i * 11u) % (size.x - 2u),
+                size.y - 2u - (i * 5u) % (size.y - 2u));
+            if (mesh[from] > 0 || mesh[to] > 0) continue;
+            callback(from, to);
+        }
+    };
+
+    SECTION("Builds abstract graph")
+    {
+        REQUIRE(navmesh.getClusterSize() == 8u);
+        REQUIRE(navmesh.getAbstractNodeCount() > 0u);
+    }
+
+    SECTION("Throws on too small clusters")
+    {
+        REQUIRE_THROWS_AS(
+            dgm::HierarchicalNavMesh(mesh.clone(), 1u), dgm::Exception);
+    }
+
+    SECTION("Finds paths whenever they exist and they are near-optimal")
+    {
+        unsigned pathLengthSum = 0;
+        unsigned optimalLengthSum = 0;
+
+        forEachQuery(
+            [&](const sf::Vector2u& from, const sf::Vector2u& to)
+            {
+                const auto path = navmesh.computePath(from, to, context);
+                const auto reference = computeBfsDistance(from, to, mesh);
+
+                REQUIRE(path.has_value() == reference.has_value());
+                if (!path) return;
+
+                REQUIRE(path->getLength() >= *reference);
+                requireValidTilePath(from, to, path->clone(), mesh);
+
+                pathLengthSum += static_cast<unsigned>(path->getLength());
+                optimalLengthSum += *reference;
+            });
+
+        REQUIRE(optimalLengthSum > 0u);
+        REQUIRE(pathLengthSum * 10u <= optimalLengthSum * 11u);
+    }
+
+    SECTION("Refining abstract path segment by segment yields full path")
+    {
+        forEachQuery(
+            [&](const sf::Vector2u& from, const sf::Vector2u& to)
+            {
+                auto waypoints = navmesh.computeAbstractPath(from, to, context);
+                auto fullPath = navmesh.computePath(from, to, context);
+                REQUIRE(waypoints.has_value() == fullPath.has_value());
+                if (!waypoints) return;
+
+                auto segmentStart = from;
+                while (!waypoints->isTraversed())
+                {
+                    const auto segmentEnd = waypoints->getCurrentPoint().coord;
+                    auto segment = navmesh.refinePathSegment(
+                        segmentStart, segmentEnd, context);
+                    REQUIRE(segment.has_value());
+
+                    while (!segment->isTraversed())
+                    {
+                        REQUIRE(
+                            segment->getCurrentPoint().coord
+                            == fullPath->getCurrentPoint().coord);
+                        segment->advance();
+                        fullPath->advance();
+                    }
+
+                    segmentStart = segmentEnd;
+                    waypoints->advance();
+                }
+
+                REQUIRE(fullPath->isTraversed());
+            });
+    }
+
+    SECTION("From-To identity")
+    {
+        const auto path = navmesh.computePath({ 1u, 2u }, { 1u, 2u });
+        REQUIRE(path.has_value());
+        REQUIRE(path->isTraversed());
+    }
+
+    SECTION("Cannot trace a path from or into wall")
+    {
+        REQUIRE_FALSE(navmesh.computePath({ 0u, 0u }, { 1u, 2u }));
+        REQUIRE_FALSE(navmesh.computePath({ 1u, 2u }, { 0u, 0u }));
+    }
+}
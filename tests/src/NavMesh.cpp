@@ -1,10 +1,18 @@
+#include "SeededRandom.hpp"
 #include "TestDataDir.hpp"
 #include <DGM/classes/Error.hpp>
 #include <DGM/classes/NavMesh.hpp>
+#include <DGM/classes/Raycaster.hpp>
 #include <DGM/classes/Utility.hpp>
 #include <algorithm>
 #include <catch2/catch_all.hpp>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
 
 #define NUMBER_DISTANCE(a, b) (std::max(a, b) - std::min(a, b))
 
@@ -28,32 +36,85 @@
     return dgm::Mesh(map, { 10u, 6u }, { 32, 32 });
 }
 
+[[nodiscard]] dgm::Mesh buildLargeMeshForTesting()
+{
+    // Bordered 64x64 map with regularly spaced pillars and walls with gaps
+    const sf::Vector2u size = { 64u, 64u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            const bool pillar = x % 4 == 2 && y % 4 == 2;
+            const bool wall = x % 16 == 8 && y % 16 != 4;
+            mesh[{ x, y }] = border || pillar || wall ? 1 : 0;
+        }
+    }
+    return mesh;
+}
+
+/**
+ *  Reference breadth-first search over 4-connected neighborhood
+ */
+[[nodiscard]] std::optional<unsigned> computeReferenceDistance(
+    const sf::Vector2u& from, const sf::Vector2u& to, const dgm::Mesh& mesh)
+{
+    const auto width = mesh.getDataSize().x;
+    auto distances = std::vector<unsigned>(
+        mesh.getRawConstData().size(), std::numeric_limits<unsigned>::max());
+    auto queue = std::deque<sf::Vector2u> { from };
+    distances[from.y * width + from.x] = 0;
+
+    while (!queue.empty())
+    {
+        const auto point = queue.front();
+        queue.pop_front();
+        if (point == to) return distances[point.y * width + point.x];
+
+        for (auto&& next : { sf::Vector2u(point.x, point.y - 1),
+                             sf::Vector2u(point.x, point.y + 1),
+                             sf::Vector2u(point.x - 1, point.y),
+                             sf::Vector2u(point.x + 1, point.y) })
+        {
+            const auto index = next.y * width + next.x;
+            if (mesh[next] > 0
+                || distances[index] != std::numeric_limits<unsigned>::max())
+                continue;
+            distances[index] = distances[point.y * width + point.x] + 1;
+            queue.push_back(next);
+        }
+    }
+
+    return std::nullopt;
+}
+
 class TestableNavMesh : public dgm::WorldNavMesh
 {
 public:
     [[nodiscard]] decltype(auto) getJumpPoints() const
     {
-        std::vector<sf::Vector2u> result;
-
-        std::transform(
-            jumpPointConnections.begin(),
-            jumpPointConnections.end(),
-            std::back_inserter(result),
-            [](const auto& itr) -> sf::Vector2u { return itr.first; });
-
-        return result;
+        return nodeCoords;
     }
 
-    [[nodiscard]] auto&& getConnections() const noexcept
+    [[nodiscard]] auto getConnections() const
     {
-        return jumpPointConnections;
+        std::unordered_map<sf::Vector2u, std::vector<Connection>> result;
+        for (NodeId node = 0; node < nodeCoords.size(); ++node)
+        {
+            auto&& connections = getNodeConnections(node);
+            result[nodeCoords[node]] = { connections.begin(),
+                                         connections.end() };
+        }
+        return result;
     }
 
     [[nodiscard]] bool
     arePointsConnected(const sf::Vector2u& a, const sf::Vector2u& b) const
     {
-        auto& connections = jumpPointConnections.at(a);
-        for (auto&& p : connections)
+        REQUIRE(isJumpPoint(a));
+        for (auto&& p : getNodeConnections(getNode(a)))
         {
             if (b == p.destination) return true;
         }
@@ -61,8 +122,34 @@ public:
     }
 
     TestableNavMesh(dgm::Mesh mesh) : dgm::WorldNavMesh(std::move(mesh)) {}
+
+    TestableNavMesh(dgm::WorldNavMesh&& navmesh)
+        : dgm::WorldNavMesh(std::move(navmesh))
+    {
+    }
 };
 
+static void requireSameNetwork(
+    const TestableNavMesh& actual, const TestableNavMesh& expected)
+{
+    const auto actualNetwork = actual.getConnections();
+    const auto expectedNetwork = expected.getConnections();
+    REQUIRE(actualNetwork.size() == expectedNetwork.size());
+    for (auto&& [point, connections] : expectedNetwork)
+    {
+        REQUIRE(actualNetwork.contains(point));
+        auto&& actualConnections = actualNetwork.at(point);
+        REQUIRE(actualConnections.size() == connections.size());
+        for (unsigned i = 0; i < connections.size(); ++i)
+        {
+            REQUIRE(
+                actualConnections[i].destination
+                == connections[i].destination);
+            REQUIRE(actualConnections[i].distance == connections[i].distance);
+        }
+    }
+}
+
 TEST_CASE("Constructing WorldNavMesh", "[WorldNavMesh]")
 {
     TestableNavMesh navmesh(buildMeshForTesting());
@@ -152,8 +239,8 @@ TEST_CASE("Constructing WorldNavMesh", "[WorldNavMesh]")
             REQUIRE(path.isTraversed());
 
             // Verify that the temporary points were cleaned up
-            auto&& connections =
-                navmesh.getConnections().at(sf::Vector2u(3u, 2u));
+            const auto network = navmesh.getConnections();
+            auto&& connections = network.at(sf::Vector2u(3u, 2u));
             REQUIRE(
                 std::find_if(
                     connections.begin(),
@@ -164,10 +251,8 @@ TEST_CASE("Constructing WorldNavMesh", "[WorldNavMesh]")
                                && conn.destination.y == 1u;
                     })
                 == connections.end());
-            REQUIRE_FALSE(
-                navmesh.getConnections().contains(sf::Vector2u(1u, 1u)));
-            REQUIRE_FALSE(
-                navmesh.getConnections().contains(sf::Vector2u(2u, 1u)));
+            REQUIRE_FALSE(network.contains(sf::Vector2u(1u, 1u)));
+            REQUIRE_FALSE(network.contains(sf::Vector2u(2u, 1u)));
         }
 
         SECTION("Normal path")
@@ -408,6 +493,832 @@ TEST_CASE("Computing Tile path", "[TileNavMesh]")
         REQUIRE_FALSE(
             dgm::TileNavMesh::computePath({ 1u, 1u }, { 6u, 1u }, mesh));
     }
+
+    SECTION("Path is optimal on a larger mesh")
+    {
+        const auto largeMesh = buildLargeMeshForTesting();
+        const std::vector<std::pair<sf::Vector2u, sf::Vector2u>> queries = {
+            { { 1u, 1u }, { 61u, 61u } },
+            { { 62u, 1u }, { 1u, 62u } },
+            { { 7u, 30u }, { 9u, 30u } },
+            { { 33u, 3u }, { 33u, 60u } },
+        };
+
+        for (auto&& [from, to] : queries)
+        {
+            const auto path =
+                dgm::TileNavMesh::computePath(from, to, largeMesh);
+            const auto reference =
+                computeReferenceDistance(from, to, largeMesh);
+            REQUIRE(path.has_value());
+            REQUIRE(reference.has_value());
+            REQUIRE(path->getLength() == *reference);
+        }
+    }
+}
+
+[[nodiscard]] dgm::Mesh buildNoisyMeshForTesting()
+{
+    // Bordered 48x48 map where roughly every fourth tile is a wall,
+    // generated from a fixed seed so the test is deterministic
+    const sf::Vector2u size = { 48u, 48u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(12345u);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            const bool noise = random.oneIn(4u);
+            mesh[{ x, y }] = border || noise ? 1 : 0;
+        }
+    }
+    return mesh;
+}
+
+/**
+ *  Validates that every step of the path moves to a passable neighbor without
+ *  cutting corners and returns the cost of the path, where straight step
+ *  costs 100 and diagonal step costs 141
+ */
+[[nodiscard]] unsigned computeTilePathCost(
+    const sf::Vector2u& from,
+    dgm::Path<dgm::TileNavpoint> path,
+    const dgm::Mesh& mesh)
+{
+    unsigned cost = 0;
+    auto previous = from;
+    while (!path.isTraversed())
+    {
+        const auto point = path.getCurrentPoint().coord;
+        const int dx = int(point.x) - int(previous.x);
+        const int dy = int(point.y) - int(previous.y);
+        REQUIRE(std::abs(dx) <= 1);
+        REQUIRE(std::abs(dy) <= 1);
+        REQUIRE((dx != 0 || dy != 0));
+        REQUIRE(mesh[point] <= 0);
+        REQUIRE(mesh[{ point.x, previous.y }] <= 0);
+        REQUIRE(mesh[{ previous.x, point.y }] <= 0);
+
+        cost += dx != 0 && dy != 0 ? 141u : 100u;
+        previous = point;
+        path.advance();
+    }
+    return cost;
+}
+
+TEST_CASE("Computing Tile path with jump point search", "[TileNavMesh]")
+{
+    using Connectivity = dgm::TileNavMesh::Connectivity;
+    using SearchAlgorithm = dgm::TileNavMesh::SearchAlgorithm;
+
+    auto meshes = std::vector<dgm::Mesh>();
+    meshes.push_back(buildMeshForTesting());
+    meshes.push_back(buildLargeMeshForTesting());
+    meshes.push_back(buildNoisyMeshForTesting());
+    auto context = dgm::PathfindingContext();
+
+    auto forEachQuery = [&](auto&& callback)
+    {
+        for (auto&& mesh : meshes)
+        {
+            const auto size = mesh.getDataSize();
+            for (unsigned i = 0; i < 40; ++i)
+            {
+                const auto from = sf::Vector2u(
+                    1u + (i * 7u) % (size.x - 2u),
+                    1u + (i * 13u) % (size.y - 2u));
+                const auto to = sf::Vector2u(
+                    size.x - 2u - (i * 11u) % (size.x - 2u),
+                    size.y - 2u - (i * 5u) % (size.y - 2u));
+                if (mesh[from] > 0 || mesh[to] > 0) continue;
+                callback(mesh, from, to);
+            }
+        }
+    };
+
+    SECTION("Four-way JPS yields paths of optimal length")
+    {
+        forEachQuery(
+            [&](const dgm::Mesh& mesh,
+                const sf::Vector2u& from,
+                const sf::Vector2u& to)
+            {
+                const auto path = dgm::TileNavMesh::computePath(
+                    from,
+                    to,
+                    mesh,
+                    context,
+                    { .algorithm = SearchAlgorithm::JumpPointSearch });
+                const auto reference =
+                    computeReferenceDistance(from, to, mesh);
+
+                REQUIRE(path.has_value() == reference.has_value());
+                if (!path) return;
+                REQUIRE(path->getLength() == *reference);
+                REQUIRE(
+                    computeTilePathCost(from, path->clone(), mesh)
+                    == *reference * 100u);
+            });
+    }
+
+    SECTION("Eight-way JPS yields paths as short as eight-way A*")
+    {
+        forEachQuery(
+            [&](const dgm::Mesh& mesh,
+                const sf::Vector2u& from,
+                const sf::Vector2u& to)
+            {
+                const auto path = dgm::TileNavMesh::computePath(
+                    from,
+                    to,
+                    mesh,
+                    context,
+                    { .algorithm = SearchAlgorithm::JumpPointSearch,
+                      .connectivity = Connectivity::EightWay });
+                const auto reference = dgm::TileNavMesh::computePath(
+                    from,
+                    to,
+                    mesh,
+                    context,
+                    { .connectivity = Connectivity::EightWay });
+
+                REQUIRE(path.has_value() == reference.has_value());
+                if (!path) return;
+                REQUIRE(
+                    computeTilePathCost(from, path->clone(), mesh)
+                    == computeTilePathCost(from, reference->clone(), mesh));
+            });
+    }
+
+    SECTION("JPS+ yields the same paths as JPS")
+    {
+        for (auto&& connectivity :
+             { Connectivity::FourWay, Connectivity::EightWay })
+        {
+            forEachQuery(
+                [&](const dgm::Mesh& mesh,
+                    const sf::Vector2u& from,
+                    const sf::Vector2u& to)
+                {
+                    const auto table =
+                        dgm::TileNavMesh::JumpPointTable(mesh, connectivity);
+                    auto path = dgm::TileNavMesh::computePath(
+                        from,
+                        to,
+                        mesh,
+                        context,
+                        { .algorithm = SearchAlgorithm::JumpPointSearch,
+                          .connectivity = connectivity,
+                          .jumpPointTable = &table });
+                    auto reference = dgm::TileNavMesh::computePath(
+                        from,
+                        to,
+                        mesh,
+                        context,
+                        { .algorithm = SearchAlgorithm::JumpPointSearch,
+                          .connectivity = connectivity });
+
+                    REQUIRE(path.has_value() == reference.has_value());
+                    if (!path) return;
+                    REQUIRE(path->getLength() == reference->getLength());
+                    while (!path->isTraversed())
+                    {
+                        REQUIRE_SAME_VECTORS(
+                            path->getCurrentPoint().coord,
+                            reference->getCurrentPoint().coord);
+                        path->advance();
+                        reference->advance();
+                    }
+                });
+        }
+    }
+
+    SECTION("Jump point table")
+    {
+        const auto mesh = buildMeshForTesting();
+        const auto table =
+            dgm::TileNavMesh::JumpPointTable(mesh, Connectivity::EightWay);
+
+        // Walking right from (3, 2) hits the wall after three steps
+        REQUIRE(table.getJumpDistance({ 3u, 2u }, { 1, 0 }) == -3);
+        // Walking right from (1, 4) reveals forced neighbor at (3, 3)
+        REQUIRE(table.getJumpDistance({ 1u, 4u }, { 1, 0 }) == 2);
+        // Walking up from (1, 4) reveals forced neighbor at (1, 2)
+        REQUIRE(table.getJumpDistance({ 1u, 4u }, { 0, -1 }) == 2);
+        // Cannot move diagonally into a wall
+        REQUIRE(table.getJumpDistance({ 1u, 4u }, { -1, -1 }) == 0);
+    }
+
+    SECTION("Diagonal steps do not cut corners")
+    {
+        // clang-format off
+        const std::vector<int> map = {
+            1, 1, 1, 1,
+            1, 0, 1, 1,
+            1, 1, 0, 1,
+            1, 1, 1, 1,
+        };
+        // clang-format on
+        const auto mesh = dgm::Mesh(map, { 4u, 4u }, { 16u, 16u });
+
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u },
+            { 2u, 2u },
+            mesh,
+            { .connectivity = Connectivity::EightWay }));
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u },
+            { 2u, 2u },
+            mesh,
+            { .algorithm = SearchAlgorithm::JumpPointSearch,
+              .connectivity = Connectivity::EightWay }));
+    }
+}
+
+TEST_CASE("Smoothing Tile path", "[TileNavMesh]")
+{
+    using Connectivity = dgm::TileNavMesh::Connectivity;
+
+    auto toTileCenter = [](const sf::Vector2u& tile, const dgm::Mesh& mesh)
+    {
+        return (sf::Vector2f(tile) + sf::Vector2f(0.5f, 0.5f))
+            .componentWiseMul(sf::Vector2f(mesh.getVoxelSize()));
+    };
+
+    SECTION("Straight path is reduced to its destination")
+    {
+        const auto mesh = buildMeshForTesting();
+        const auto path =
+            dgm::TileNavMesh::computePath({ 1u, 1u }, { 5u, 1u }, mesh);
+        REQUIRE(path->getLength() == 4u);
+
+        auto smoothed = dgm::TileNavMesh::smoothPath({ 1u, 1u }, *path, mesh);
+        REQUIRE(smoothed.getLength() == 1u);
+        REQUIRE(smoothed.getCurrentPoint().coord == sf::Vector2u(5u, 1u));
+    }
+
+    SECTION("Empty path stays empty")
+    {
+        const auto mesh = buildMeshForTesting();
+        const auto path =
+            dgm::TileNavMesh::computePath({ 1u, 1u }, { 1u, 1u }, mesh);
+        REQUIRE(dgm::TileNavMesh::smoothPath({ 1u, 1u }, *path, mesh)
+                    .isTraversed());
+    }
+
+    SECTION("Smoothed path is a visible subsequence of the original")
+    {
+        auto meshes = std::vector<dgm::Mesh>();
+        meshes.push_back(buildLargeMeshForTesting());
+        meshes.push_back(buildNoisyMeshForTesting());
+
+        for (auto&& mesh : meshes)
+        {
+            const auto size = mesh.getDataSize();
+            for (auto&& connectivity :
+                 { Connectivity::FourWay, Connectivity::EightWay })
+            {
+                for (unsigned i = 0; i < 30; ++i)
+                {
+                    const auto from = sf::Vector2u(
+                        1u + (i * 7u) % (size.x - 2u),
+                        1u + (i * 13u) % (size.y - 2u));
+                    const auto to = sf::Vector2u(
+                        size.x - 2u - (i * 11u) % (size.x - 2u),
+                        size.y - 2u - (i * 5u) % (size.y - 2u));
+                    if (mesh[from] > 0 || mesh[to] > 0) continue;
+
+                    auto path = dgm::TileNavMesh::computePath(
+                        from, to, mesh, { .connectivity = connectivity });
+                    if (!path || path->isTraversed()) continue;
+
+                    auto smoothed =
+                        dgm::TileNavMesh::smoothPath(from, *path, mesh);
+                    REQUIRE(smoothed.getLength() <= path->getLength());
+
+                    auto previous = from;
+                    while (!smoothed.isTraversed())
+                    {
+                        const auto point = smoothed.getCurrentPoint().coord;
+                        REQUIRE(dgm::Raycaster::hasDirectVisibility(
+                            toTileCenter(previous, mesh),
+                            toTileCenter(point, mesh),
+                            mesh));
+
+                        // Skip to the same point in the original path
+                        while (path->getCurrentPoint().coord != point)
+                            path->advance();
+
+                        previous = point;
+                        smoothed.advance();
+                    }
+                    REQUIRE(previous == to);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Reusing pathfinding context", "[NavMesh]")
+{
+    const auto smallMesh = buildMeshForTesting();
+    const auto largeMesh = buildLargeMeshForTesting();
+    auto context = dgm::PathfindingContext(smallMesh.getDataSize());
+
+    SECTION("TileNavMesh yields same paths as with fresh context")
+    {
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            auto path1 = dgm::TileNavMesh::computePath(
+                { 1u, 4u }, { 5u, 1u }, smallMesh, context);
+            REQUIRE(path1.has_value());
+            REQUIRE(path1->getLength() == 7u);
+
+            // Context has to grow for the larger mesh
+            auto path2 = dgm::TileNavMesh::computePath(
+                { 1u, 1u }, { 61u, 61u }, largeMesh, context);
+            auto reference = dgm::TileNavMesh::computePath(
+                { 1u, 1u }, { 61u, 61u }, largeMesh);
+            REQUIRE(path2.has_value());
+            REQUIRE(path2->getLength() == reference->getLength());
+
+            while (!path2->isTraversed())
+            {
+                REQUIRE_SAME_VECTORS(
+                    path2->getCurrentPoint().coord,
+                    reference->getCurrentPoint().coord);
+                path2->advance();
+                reference->advance();
+            }
+
+            REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+                { 1u, 1u }, { 8u, 1u }, smallMesh, context));
+        }
+    }
+
+    SECTION("WorldNavMesh yields same paths as with fresh context")
+    {
+        auto navmesh = dgm::WorldNavMesh(buildMeshForTesting());
+
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            auto path = navmesh.computePath(
+                { 5.5f * 32.f, 1.5f * 32.f },
+                { 1.5f * 32.f, 3.5f * 32.f },
+                context);
+            REQUIRE(path.getLength() == 2u);
+            REQUIRE_SAME_VECTORS(
+                path.getCurrentPoint().coord, sf::Vector2f(48.f, 80.f));
+
+            REQUIRE(navmesh
+                        .computePath(
+                            { 1.5f * 32.f, 1.5f * 32.f },
+                            { 8.5f * 32.f, 1.5f * 32.f },
+                            context)
+                        .isTraversed());
+        }
+    }
+}
+
+TEST_CASE("Computing distances", "[NavMesh]")
+{
+    using SearchOptions = dgm::TileNavMesh::SearchOptions;
+    using Connectivity = dgm::TileNavMesh::Connectivity;
+
+    const auto mesh = buildLargeMeshForTesting();
+
+    // Pillars, walls, unreachable corner, duplicates and the source itself
+    const sf::Vector2u from = { 3u, 5u };
+    std::vector<sf::Vector2u> targets = { from, { 2u, 2u }, { 0u, 0u } };
+    for (unsigned i = 0; i < 40; ++i)
+        targets.emplace_back(1u + (i * 17u) % 62u, 1u + (i * 29u) % 62u);
+    targets.push_back(targets.back());
+
+    SECTION("TileNavMesh distance matches length of the path")
+    {
+        for (auto&& options :
+             { SearchOptions {},
+               SearchOptions { .connectivity = Connectivity::EightWay } })
+        {
+            for (auto&& to : targets)
+            {
+                const auto distance =
+                    dgm::TileNavMesh::computeDistance(from, to, mesh, options);
+                auto path =
+                    dgm::TileNavMesh::computePath(from, to, mesh, options);
+                REQUIRE(distance.has_value() == path.has_value());
+                if (!path) continue;
+
+                unsigned expected = 0;
+                auto previous = from;
+                while (!path->isTraversed())
+                {
+                    const auto current = path->getCurrentPoint().coord;
+                    expected += previous.x != current.x
+                                        && previous.y != current.y
+                                    ? dgm::TileNavMesh::DIAGONAL_COST
+                                    : dgm::TileNavMesh::STRAIGHT_COST;
+                    previous = current;
+                    path->advance();
+                }
+                REQUIRE(*distance == expected);
+            }
+        }
+    }
+
+    SECTION("TileNavMesh batch matches individual queries")
+    {
+        auto context = dgm::PathfindingContext(mesh.getDataSize());
+        for (auto&& options :
+             { SearchOptions {},
+               SearchOptions { .connectivity = Connectivity::EightWay } })
+        {
+            const auto distances = dgm::TileNavMesh::computeDistances(
+                from, targets, mesh, context, options);
+            REQUIRE(distances.size() == targets.size());
+            for (std::size_t i = 0; i < targets.size(); ++i)
+            {
+                REQUIRE(
+                    distances[i]
+                    == dgm::TileNavMesh::computeDistance(
+                        from, targets[i], mesh, context, options));
+            }
+        }
+
+        REQUIRE(dgm::TileNavMesh::computeDistances(from, {}, mesh).empty());
+        REQUIRE_FALSE(dgm::TileNavMesh::computeDistance(
+            { 0u, 0u }, { 0u, 0u }, mesh));
+    }
+
+    const auto navmesh = dgm::WorldNavMesh(mesh.clone());
+    auto toWorld = [](const sf::Vector2u& tile)
+    { return sf::Vector2f(tile.x * 16.f + 5.f, tile.y * 16.f + 11.f); };
+
+    std::vector<sf::Vector2f> worldTargets;
+    for (auto&& target : targets)
+        worldTargets.push_back(toWorld(target));
+
+    SECTION("WorldNavMesh distance matches length of the path")
+    {
+        for (auto&& to : worldTargets)
+        {
+            const auto distance = navmesh.computeDistance(toWorld(from), to);
+            auto path = navmesh.computePath(toWorld(from), to);
+            if (path.isTraversed())
+            {
+                REQUIRE((!distance || *distance == 0.f));
+                continue;
+            }
+
+            float expected = 0.f;
+            auto previous = sf::Vector2f(from) * 16.f + sf::Vector2f(8.f, 8.f);
+            while (!path.isTraversed())
+            {
+                const auto current = path.getCurrentPoint().coord;
+                expected += std::floor((current - previous).length());
+                previous = current;
+                path.advance();
+            }
+            REQUIRE(*distance == expected);
+        }
+    }
+
+    SECTION("WorldNavMesh batch matches individual queries")
+    {
+        auto context = dgm::PathfindingContext(mesh.getDataSize());
+        const auto distances =
+            navmesh.computeDistances(toWorld(from), worldTargets, context);
+        REQUIRE(distances.size() == worldTargets.size());
+        REQUIRE(
+            std::ranges::count_if(
+                distances, [](auto&& distance) { return distance > 0.f; })
+            > 30);
+        for (std::size_t i = 0; i < worldTargets.size(); ++i)
+        {
+            REQUIRE(
+                distances[i]
+                == navmesh.computeDistance(
+                    toWorld(from), worldTargets[i], context));
+        }
+    }
+}
+
+TEST_CASE("Computing batch of paths", "[WorldNavMesh]")
+{
+    const auto navmesh = dgm::WorldNavMesh(buildLargeMeshForTesting());
+
+    std::vector<dgm::WorldNavMesh::PathRequest> requests;
+    for (unsigned i = 1; i < 62; i += 3)
+    {
+        requests.push_back(dgm::WorldNavMesh::PathRequest {
+            .from = { 24.f, i * 16.f + 8.f },
+            .to = { 60.5f * 16.f, (62.5f - i) * 16.f },
+        });
+    }
+
+    for (unsigned threadCount : { 0u, 1u, 4u, 64u })
+    {
+        auto paths = navmesh.computePaths(requests, threadCount);
+        REQUIRE(paths.size() == requests.size());
+
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            auto& path = paths[i];
+            auto reference =
+                navmesh.computePath(requests[i].from, requests[i].to);
+            REQUIRE(path.getLength() == reference.getLength());
+            REQUIRE_FALSE(path.isTraversed());
+
+            while (!path.isTraversed())
+            {
+                REQUIRE_SAME_VECTORS(
+                    path.getCurrentPoint().coord,
+                    reference.getCurrentPoint().coord);
+                path.advance();
+                reference.advance();
+            }
+        }
+    }
+
+    SECTION("Empty batch")
+    {
+        REQUIRE(navmesh.computePaths({}).empty());
+    }
+}
+
+TEST_CASE("Updating WorldNavMesh incrementally", "[WorldNavMesh]")
+{
+    SECTION("Opening a door connects two rooms")
+    {
+        auto navmesh = TestableNavMesh(buildMeshForTesting());
+        const auto from = sf::Vector2f(1.5f * 32.f, 1.5f * 32.f);
+        const auto to = sf::Vector2f(8.5f * 32.f, 1.5f * 32.f);
+        REQUIRE(navmesh.computePath(from, to).isTraversed());
+
+        navmesh.setTile({ 7u, 2u }, 0);
+        REQUIRE(navmesh.hasPendingChanges());
+        navmesh.applyChanges();
+        REQUIRE_FALSE(navmesh.hasPendingChanges());
+
+        REQUIRE_FALSE(navmesh.computePath(from, to).isTraversed());
+
+        auto mesh = buildMeshForTesting();
+        mesh.setTile({ 7u, 2u }, 0);
+        requireSameNetwork(navmesh, TestableNavMesh(std::move(mesh)));
+    }
+
+    SECTION("Setting the same value does not mark the mesh as dirty")
+    {
+        auto navmesh = TestableNavMesh(buildMeshForTesting());
+        navmesh.setTile({ 7u, 2u }, 1);
+        REQUIRE_FALSE(navmesh.hasPendingChanges());
+    }
+
+    SECTION("Network is the same as if it was built from scratch")
+    {
+        auto mesh = buildLargeMeshForTesting();
+        auto navmesh = TestableNavMesh(mesh.clone());
+
+        auto random = SeededRandom(7u);
+
+        for (unsigned round = 0; round < 20; ++round)
+        {
+            // Changes are clustered, similar to an explosion or a door
+            const auto center =
+                sf::Vector2u(2u + random(60u), 2u + random(60u));
+            for (unsigned i = 0; i < 1u + random(6u); ++i)
+            {
+                const auto tile = sf::Vector2u(
+                    center.x - 1u + random(3u), center.y - 1u + random(3u));
+                const int value = static_cast<int>(random(2u));
+                mesh.setTile(tile, value);
+                navmesh.setTile(tile, value);
+            }
+            navmesh.applyChanges();
+
+            requireSameNetwork(navmesh, TestableNavMesh(mesh.clone()));
+        }
+    }
+}
+
+TEST_CASE("Constructing WorldNavMesh in parallel", "[WorldNavMesh]")
+{
+    auto mesh = buildLargeMeshForTesting();
+    const auto serial = TestableNavMesh(dgm::WorldNavMesh(mesh.clone(), 1u));
+
+    SECTION("Network does not depend on the number of threads")
+    {
+        for (unsigned threadCount : { 0u, 2u, 3u, 8u, 1000u })
+        {
+            requireSameNetwork(
+                TestableNavMesh(dgm::WorldNavMesh(mesh.clone(), threadCount)),
+                serial);
+        }
+    }
+
+    SECTION("Parallel build can be updated incrementally")
+    {
+        auto navmesh = TestableNavMesh(dgm::WorldNavMesh(mesh.clone(), 4u));
+        for (auto&& tile : { sf::Vector2u(10u, 10u),
+                             sf::Vector2u(33u, 20u),
+                             sf::Vector2u(50u, 47u) })
+        {
+            mesh.setTile(tile, mesh[tile] > 0 ? 0 : 1);
+            navmesh.setTile(tile, mesh[tile]);
+        }
+        navmesh.applyChanges();
+
+        requireSameNetwork(navmesh, TestableNavMesh(mesh.clone()));
+    }
+}
+
+TEST_CASE("Saving and loading WorldNavMesh", "[WorldNavMesh]")
+{
+    const auto path =
+        std::filesystem::temp_directory_path() / "dgm_worldnavmesh.bin";
+    auto mesh = buildLargeMeshForTesting();
+    auto navmesh = TestableNavMesh(mesh.clone());
+    REQUIRE(navmesh.saveToFile(path));
+
+    SECTION("Loaded navmesh yields the same paths")
+    {
+        auto loaded = dgm::WorldNavMesh::loadFromFile(mesh.clone(), path);
+        REQUIRE(loaded);
+
+        for (unsigned i = 0; i < 20; ++i)
+        {
+            const auto from =
+                sf::Vector2f(24.f + i * 48.f, 24.f + (i * 7 % 20) * 48.f);
+            const auto to =
+                sf::Vector2f(1000.f - i * 40.f, 24.f + (i * 3 % 20) * 50.f);
+
+            auto expected = navmesh.computePath(from, to);
+            auto actual = loaded->computePath(from, to);
+            REQUIRE(expected.getLength() == actual.getLength());
+            while (!expected.isTraversed())
+            {
+                REQUIRE_SAME_VECTORS(
+                    expected.getCurrentPoint().coord,
+                    actual.getCurrentPoint().coord);
+                expected.advance();
+                actual.advance();
+            }
+        }
+    }
+
+    SECTION("Loaded navmesh can be updated incrementally")
+    {
+        auto loaded = dgm::WorldNavMesh::loadFromFile(mesh.clone(), path);
+        REQUIRE(loaded);
+
+        auto network = TestableNavMesh(std::move(*loaded));
+        requireSameNetwork(network, navmesh);
+
+        for (unsigned y = 10; y < 14; ++y)
+        {
+            mesh.setTile({ 12u, y }, 1);
+            network.setTile({ 12u, y }, 1);
+        }
+        network.applyChanges();
+        requireSameNetwork(network, TestableNavMesh(mesh.clone()));
+    }
+
+    SECTION("File saved for a different mesh is rejected")
+    {
+        mesh.setTile({ 12u, 10u }, mesh[{ 12u, 10u }] > 0 ? 0 : 1);
+        REQUIRE_FALSE(dgm::WorldNavMesh::loadFromFile(mesh.clone(), path));
+
+        auto otherVoxelSize = dgm::Mesh(
+            buildLargeMeshForTesting().getRawConstData(),
+            mesh.getDataSize(),
+            { 32u, 32u });
+        REQUIRE_FALSE(
+            dgm::WorldNavMesh::loadFromFile(std::move(otherVoxelSize), path));
+    }
+
+    SECTION("File with scan bounds outside of the mesh is rejected")
+    {
+        // Bottom right corner of the scan bounds of the first node follows
+        // magic, header, wall layout hash, counts and the node coordinates
+        constexpr std::streamoff SCAN_BOUNDS_RIGHT =
+            8 + 5 * 4 + 8 + 2 * 4 + 4 * 4;
+        {
+            auto stream = std::fstream(
+                path, std::ios::binary | std::ios::in | std::ios::out);
+            stream.seekp(SCAN_BOUNDS_RIGHT);
+            const std::uint32_t outside = mesh.getDataSize().x + 1u;
+            stream.write(
+                reinterpret_cast<const char*>(&outside), sizeof(outside));
+        }
+        REQUIRE_FALSE(dgm::WorldNavMesh::loadFromFile(mesh.clone(), path));
+    }
+
+    SECTION("Corrupted file is rejected")
+    {
+        std::filesystem::resize_file(
+            path, std::filesystem::file_size(path) - 4u);
+        REQUIRE_FALSE(dgm::WorldNavMesh::loadFromFile(mesh.clone(), path));
+
+        std::filesystem::remove(path);
+        REQUIRE_FALSE(dgm::WorldNavMesh::loadFromFile(mesh.clone(), path));
+    }
+
+    SECTION("Navmesh with pending changes cannot be saved")
+    {
+        navmesh.setTile({ 12u, 10u }, mesh[{ 12u, 10u }] > 0 ? 0 : 1);
+        REQUIRE_FALSE(navmesh.saveToFile(path));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Computing WorldNavMesh path with landmarks", "[WorldNavMesh]")
+{
+    // Serpentine corridors with pillars, straight line distance is a poor
+    // estimate of the remaining distance there
+    const sf::Vector2u size = { 41u, 41u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            const bool gapOnLeft = (y / 4) % 2 == 0;
+            const bool wall =
+                y % 4 == 0 && (gapOnLeft ? x > 2 : x < size.x - 3);
+            const bool pillar = x % 6 == 3 && y % 4 == 2;
+            mesh[{ x, y }] = border || wall || pillar ? 1 : 0;
+        }
+    }
+
+    // Cost of the path as computed by the navmesh
+    auto getPathCost = [](const sf::Vector2f& from,
+                          dgm::Path<dgm::WorldNavpoint> path)
+    {
+        auto previous = sf::Vector2f(
+            (std::floor(from.x / 16.f) + 0.5f) * 16.f,
+            (std::floor(from.y / 16.f) + 0.5f) * 16.f);
+        unsigned cost = 0;
+        for (; !path.isTraversed(); path.advance())
+        {
+            const auto current = path.getCurrentPoint().coord;
+            cost += static_cast<unsigned>((current - previous).length());
+            previous = current;
+        }
+        return cost;
+    };
+
+    const auto plain = dgm::WorldNavMesh(mesh.clone());
+    auto navmesh = TestableNavMesh(mesh.clone());
+    navmesh.computeLandmarks(4u);
+    REQUIRE(navmesh.getLandmarkCount() == 4u);
+
+    SECTION("Paths are as short as without landmarks")
+    {
+        for (unsigned i = 0; i < 40; ++i)
+        {
+            const auto from = sf::Vector2f(
+                24.f + (i * 7u % 39u) * 16.f, 24.f + (i * 11u % 39u) * 16.f);
+            const auto to = sf::Vector2f(
+                24.f + (i * 13u % 39u) * 16.f, 24.f + (i * 5u % 39u) * 16.f);
+
+            auto expected = plain.computePath(from, to);
+            auto actual = navmesh.computePath(from, to);
+            REQUIRE(expected.isTraversed() == actual.isTraversed());
+            REQUIRE(
+                getPathCost(from, std::move(expected))
+                == getPathCost(from, std::move(actual)));
+        }
+    }
+
+    SECTION("Landmarks are recomputed when the mesh changes")
+    {
+        mesh.setTile({ 1u, 4u }, 1);
+        mesh.setTile({ 2u, 4u }, 1);
+        navmesh.setTile({ 1u, 4u }, 1);
+        navmesh.setTile({ 2u, 4u }, 1);
+        navmesh.applyChanges();
+        REQUIRE(navmesh.getLandmarkCount() == 4u);
+
+        const auto fresh = dgm::WorldNavMesh(mesh.clone());
+        const auto from = sf::Vector2f(24.f, 24.f);
+        const auto to = sf::Vector2f(600.f, 600.f);
+        REQUIRE(
+            getPathCost(from, navmesh.computePath(from, to))
+            == getPathCost(from, fresh.computePath(from, to)));
+    }
+
+    SECTION("Landmark count is limited by the number of jump points")
+    {
+        navmesh.computeLandmarks(100000u);
+        REQUIRE(navmesh.getLandmarkCount() == navmesh.getJumpPoints().size());
+
+        navmesh.computeLandmarks(0u);
+        REQUIRE(navmesh.getLandmarkCount() == 0u);
+    }
 }
 
 TEST_CASE("BUGS", "[WorldNavMesh]")
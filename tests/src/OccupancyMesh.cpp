@@ -0,0 +1,174 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/Collision.hpp>
+#include <DGM/classes/OccupancyMesh.hpp>
+#include <catch2/catch_all.hpp>
+
+[[nodiscard]] static dgm::Mesh buildMeshForOccupancyTesting()
+{
+    // Width spans several words and is not a multiple of the word size
+    const sf::Vector2u size = { 150u, 40u };
+    auto mesh = dgm::Mesh(size, { 8u, 8u });
+    auto random = SeededRandom(5u);
+    for (auto&& tile : mesh.getRawData())
+        tile = random.oneIn(10u) ? 1 : 0;
+    mesh.setPosition({ 30.f, 20.f });
+    return mesh;
+}
+
+static void
+requireSameOccupancy(const dgm::OccupancyMesh& occupancy, const dgm::Mesh& mesh)
+{
+    REQUIRE(occupancy.getDataSize() == mesh.getDataSize());
+    std::size_t count = 0;
+    for (unsigned y = 0; y < mesh.getDataSize().y; ++y)
+    {
+        for (unsigned x = 0; x < mesh.getDataSize().x; ++x)
+        {
+            REQUIRE(occupancy.isOccupied({ x, y }) == (mesh[{ x, y }] > 0));
+            count += mesh[{ x, y }] > 0 ? 1u : 0u;
+        }
+    }
+    REQUIRE(
+        occupancy.countOccupiedTiles(
+            { 0u, 0u }, mesh.getDataSize() - sf::Vector2u(1u, 1u))
+        == count);
+}
+
+TEST_CASE("[OccupancyMesh]")
+{
+    auto mesh = buildMeshForOccupancyTesting();
+    auto occupancy = dgm::OccupancyMesh(mesh);
+
+    SECTION("Tiles are packed correctly")
+    {
+        requireSameOccupancy(occupancy, mesh);
+        REQUIRE(occupancy.getVoxelSize() == mesh.getVoxelSize());
+        REQUIRE(occupancy.getPosition() == mesh.getPosition());
+    }
+
+    SECTION("Rectangle queries match tile by tile scan")
+    {
+        for (unsigned i = 0; i < 50; ++i)
+        {
+            const auto topLeft = sf::Vector2u((i * 37u) % 150u, (i * 7u) % 40u);
+            const auto bottomRight = sf::Vector2u(
+                std::min(topLeft.x + (i * 13u) % 90u, 149u),
+                std::min(topLeft.y + i % 5u, 39u));
+
+            std::size_t count = 0;
+            std::optional<sf::Vector2u> first;
+            for (unsigned y = topLeft.y; y <= bottomRight.y; ++y)
+            {
+                for (unsigned x = topLeft.x; x <= bottomRight.x; ++x)
+                {
+                    if (mesh[{ x, y }] <= 0) continue;
+                    ++count;
+                    if (!first) first = sf::Vector2u(x, y);
+                }
+            }
+
+            REQUIRE(
+                occupancy.countOccupiedTiles(topLeft, bottomRight) == count);
+            REQUIRE(occupancy.findOccupiedTile(topLeft, bottomRight) == first);
+        }
+    }
+
+    SECTION("Incremental updates match a rebuild")
+    {
+        auto random = SeededRandom(17u);
+        for (unsigned round = 0; round < 100; ++round)
+        {
+            const auto topLeft = sf::Vector2u(random(150u), random(40u));
+            const auto bottomRight = topLeft + sf::Vector2u(70u, 2u);
+            for (unsigned y = topLeft.y; y <= std::min(bottomRight.y, 39u); ++y)
+            {
+                for (unsigned x = topLeft.x;
+                     x <= std::min(bottomRight.x, 149u);
+                     ++x)
+                    mesh.setTile({ x, y }, (x + y + round) % 3u == 0u ? 1 : 0);
+            }
+
+            occupancy.update(mesh, topLeft, bottomRight);
+            REQUIRE(occupancy.getMeshVersion() == mesh.getVersion());
+        }
+        requireSameOccupancy(occupancy, mesh);
+    }
+
+    SECTION("Resized mesh is packed again")
+    {
+        mesh.setDataSize(70u, 3u);
+        mesh.setTile({ 69u, 2u }, 1);
+        occupancy.update(mesh, { 69u, 2u });
+        requireSameOccupancy(occupancy, mesh);
+    }
+}
+
+TEST_CASE("Occupancy-mesh-to-body", "Collision")
+{
+    const auto mesh = buildMeshForOccupancyTesting();
+    const auto occupancy = dgm::OccupancyMesh(mesh);
+
+    // Bodies within the mesh, overlapping its right and bottom edges and
+    // completely outside of it
+    auto random = SeededRandom(9u);
+
+    for (unsigned i = 0; i < 500; ++i)
+    {
+        const auto position =
+            sf::Vector2f(61.f + random(1300u), 51.f + random(360u));
+        const auto circle = dgm::Circle(position, 1.f + random(30u));
+        const auto rect = dgm::Rect(
+            position, sf::Vector2f(1.f + random(200u), 1.f + random(20u)));
+
+        std::size_t expectedHit = 0, hit = 0;
+        REQUIRE(
+            dgm::Collision::basic(occupancy, circle, &hit)
+            == dgm::Collision::basic(mesh, circle, &expectedHit));
+        REQUIRE(hit == expectedHit);
+
+        REQUIRE(
+            dgm::Collision::basic(occupancy, rect, &hit)
+            == dgm::Collision::basic(mesh, rect, &expectedHit));
+        REQUIRE(hit == expectedHit);
+    }
+
+    SECTION("Bodies outside of the mesh never collide")
+    {
+        REQUIRE_FALSE(dgm::Collision::basic(
+            occupancy, dgm::Rect({ -100.f, -100.f }, { 50.f, 50.f })));
+        REQUIRE_FALSE(dgm::Collision::basic(
+            occupancy, dgm::Circle({ 5000.f, 100.f }, 10.f)));
+    }
+
+    SECTION("Bodies just left of and above the mesh")
+    {
+        // clang-format off
+        auto cornerMesh = dgm::Mesh(
+            std::vector<int> {
+                1, 0, 0,
+                0, 0, 0,
+            },
+            { 3u, 2u },
+            { 8u, 8u });
+        // clang-format on
+        cornerMesh.setPosition({ 30.f, 20.f });
+        const auto corner = dgm::OccupancyMesh(cornerMesh);
+
+        // Less than a tile away from the wall in the corner
+        REQUIRE_FALSE(dgm::Collision::basic(
+            corner, dgm::Rect({ 25.f, 20.f }, { 4.5f, 4.f })));
+        REQUIRE_FALSE(dgm::Collision::basic(
+            corner, dgm::Rect({ 31.f, 14.f }, { 4.f, 5.5f })));
+        REQUIRE_FALSE(
+            dgm::Collision::basic(corner, dgm::Circle({ 26.f, 24.f }, 3.f)));
+        REQUIRE_FALSE(
+            dgm::Collision::basic(corner, dgm::Circle({ 34.f, 16.f }, 3.f)));
+
+        std::size_t hit = 1;
+        REQUIRE(dgm::Collision::basic(
+            corner, dgm::Rect({ 25.f, 20.f }, { 6.f, 4.f }), &hit));
+        REQUIRE(hit == 0u);
+        REQUIRE(
+            dgm::Collision::basic(corner, dgm::Circle({ 34.f, 16.f }, 5.f)));
+    }
+}
@@ -67,4 +67,79 @@ namespace PathTests
         }
     }
 
+    TEST_CASE("Sharing points", "Path")
+    {
+        SECTION("Clones share points but not the current point")
+        {
+            auto path1 = dgm::Path(POINTS, false);
+            path1.advance();
+            auto path2 = path1.clone();
+            path2.advance();
+
+            REQUIRE(path1.getSharedPoints() == path2.getSharedPoints());
+            REQUIRE(path1.getCurrentPoint().coord.x == 1u);
+            REQUIRE(path2.getCurrentPoint().coord.x == 2u);
+        }
+
+        SECTION("Path can be created from shared points")
+        {
+            const auto points =
+                std::make_shared<const std::vector<dgm::TileNavpoint>>(
+                    POINTS);
+            auto path = dgm::Path<dgm::TileNavpoint>::fromSharedPoints(
+                points, true);
+
+            REQUIRE(path.getSharedPoints() == points);
+            REQUIRE(path.isLooping());
+            REQUIRE(path.getPoints().size() == 3u);
+            REQUIRE(path.getCurrentPoint().value == 10u);
+        }
+
+        SECTION("Moved path keeps its points")
+        {
+            auto path1 = dgm::Path(POINTS, false);
+            auto path2 = std::move(path1);
+            REQUIRE(path2.getLength() == 3u);
+        }
+    }
+
+    TEST_CASE("Cursor", "PathCursor")
+    {
+        SECTION("Non-looping")
+        {
+            auto cursor = dgm::PathCursor();
+            REQUIRE_FALSE(cursor.isTraversed(2u));
+            cursor.advance(2u);
+            REQUIRE(cursor.getIndex() == 1u);
+            cursor.advance(2u);
+            REQUIRE(cursor.isTraversed(2u));
+        }
+
+        SECTION("Looping")
+        {
+            auto cursor = dgm::PathCursor(true);
+            cursor.advance(2u);
+            cursor.advance(2u);
+            REQUIRE(cursor.getIndex() == 0u);
+            REQUIRE_FALSE(cursor.isTraversed(2u));
+        }
+
+        SECTION("Many cursors over the same points")
+        {
+            const auto path = dgm::Path(POINTS, false);
+            auto cursors = std::vector<dgm::PathCursor>(3);
+            for (std::size_t i = 0; i < cursors.size(); ++i)
+            {
+                for (std::size_t j = 0; j < i; ++j)
+                    cursors[i].advance(path.getLength());
+            }
+
+            for (std::size_t i = 0; i < cursors.size(); ++i)
+            {
+                REQUIRE(
+                    path.getPoints()[cursors[i].getIndex()].coord
+                    == POINTS[i].coord);
+            }
+        }
+    }
 } // namespace PathTests
@@ -0,0 +1,229 @@
+#include <DGM/classes/NavMesh.hpp>
+#include <DGM/classes/PathCache.hpp>
+#include <catch2/catch_all.hpp>
+
+[[nodiscard]] static dgm::Mesh buildMeshForCacheTesting()
+{
+    // clang-format off
+    const std::vector<int> map = {
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1, 0, 0, 0, 0, 0, 1, 1, 0, 1,
+        1, 0, 0, 0, 0, 0, 0, 1, 0, 1,
+        1, 0, 1, 0, 0, 0, 0, 1, 0, 1,
+        1, 0, 0, 0, 0, 0, 0, 1, 0, 1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+    };
+    // clang-format on
+
+    return dgm::Mesh(map, { 10u, 6u }, { 32u, 32u });
+}
+
+template<class T>
+static void
+requireSamePaths(std::optional<dgm::Path<T>> a, std::optional<dgm::Path<T>> b)
+{
+    REQUIRE(a.has_value() == b.has_value());
+    if (!a) return;
+
+    REQUIRE(a->getLength() == b->getLength());
+    while (!a->isTraversed())
+    {
+        REQUIRE(a->getCurrentPoint().coord == b->getCurrentPoint().coord);
+        a->advance();
+        b->advance();
+    }
+}
+
+TEST_CASE("[MeshVersion]")
+{
+    auto mesh = buildMeshForCacheTesting();
+    const auto version = mesh.getVersion();
+
+    SECTION("Const access keeps the version")
+    {
+        const auto& constMesh = mesh;
+        [[maybe_unused]] const int value = constMesh[{ 1u, 1u }];
+        REQUIRE(mesh.getVersion() == version);
+    }
+
+    SECTION("Non-const reads keep the version")
+    {
+        [[maybe_unused]] const int value = mesh[{ 1u, 1u }];
+        [[maybe_unused]] const auto& data = mesh.getRawData();
+        REQUIRE(mesh.getVersion() == version);
+    }
+
+    SECTION("Writing a tile changes the version")
+    {
+        mesh.setTile({ 1u, 1u }, 1);
+        REQUIRE(mesh.getVersion() != version);
+    }
+
+    SECTION("Raw writes change the version once marked")
+    {
+        mesh.getRawData()[0] = 1;
+        mesh.markModified();
+        REQUIRE(mesh.getVersion() != version);
+    }
+
+    SECTION("Resizing changes the version")
+    {
+        mesh.setDataSize({ 2u, 2u });
+        REQUIRE(mesh.getVersion() != version);
+    }
+
+    SECTION("Cloned mesh has a different version")
+    {
+        REQUIRE(mesh.clone().getVersion() != version);
+    }
+}
+
+TEST_CASE("[PathCache]")
+{
+    using Connectivity = dgm::TileNavMesh::Connectivity;
+
+    auto mesh = buildMeshForCacheTesting();
+    auto cache = dgm::PathCache<dgm::TileNavpoint>();
+
+    SECTION("Repeated queries are served from the cache")
+    {
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            requireSamePaths(
+                dgm::TileNavMesh::computePath({ 1u, 1u }, { 6u, 4u }, mesh),
+                dgm::TileNavMesh::computePath(
+                    { 1u, 1u }, { 6u, 4u }, mesh, cache));
+        }
+
+        REQUIRE(cache.getStatistics().missCount == 1u);
+        REQUIRE(cache.getStatistics().hitCount == 2u);
+        REQUIRE(cache.getSize() == 1u);
+    }
+
+    SECTION("Unreachable destinations are cached as well")
+    {
+        for (unsigned i = 0; i < 2; ++i)
+        {
+            REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+                { 1u, 1u }, { 8u, 1u }, mesh, cache));
+        }
+
+        REQUIRE(cache.getStatistics().missCount == 1u);
+        REQUIRE(cache.getStatistics().hitCount == 1u);
+    }
+
+    SECTION("Modifying the mesh invalidates the cache")
+    {
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, cache));
+
+        mesh.setTile({ 7u, 2u }, 0);
+
+        REQUIRE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, cache));
+        REQUIRE(cache.getStatistics().missCount == 2u);
+        REQUIRE(cache.getStatistics().invalidationCount == 1u);
+        REQUIRE(cache.getSize() == 1u);
+    }
+
+    SECTION("Raw writes invalidate the cache once marked")
+    {
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, cache));
+
+        mesh[{ 7u, 2u }] = 0;
+        REQUIRE_FALSE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, cache));
+        REQUIRE(cache.getStatistics().invalidationCount == 0u);
+
+        mesh.markModified();
+        REQUIRE(dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 8u, 1u }, mesh, cache));
+        REQUIRE(cache.getStatistics().invalidationCount == 1u);
+    }
+
+    SECTION("Queries with different options are cached separately")
+    {
+        const auto fourWay = dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 5u, 4u }, mesh, cache);
+        const auto eightWay = dgm::TileNavMesh::computePath(
+            { 1u, 1u },
+            { 5u, 4u },
+            mesh,
+            cache,
+            { .connectivity = Connectivity::EightWay });
+
+        REQUIRE(fourWay->getLength() == 7u);
+        REQUIRE(eightWay->getLength() == 4u);
+        REQUIRE(cache.getStatistics().missCount == 2u);
+    }
+
+    SECTION("Least recently used result is evicted")
+    {
+        cache = dgm::PathCache<dgm::TileNavpoint>(2u);
+        auto query = [&](const sf::Vector2u& to)
+        {
+            return dgm::TileNavMesh::computePath({ 1u, 1u }, to, mesh, cache);
+        };
+
+        (void)query({ 2u, 1u });
+        (void)query({ 3u, 1u });
+        (void)query({ 2u, 1u }); // hit
+        (void)query({ 4u, 1u }); // evicts { 3u, 1u }
+        (void)query({ 2u, 1u }); // hit
+        (void)query({ 3u, 1u }); // miss, evicts { 4u, 1u }
+
+        REQUIRE(cache.getSize() == 2u);
+        REQUIRE(cache.getStatistics().hitCount == 2u);
+        REQUIRE(cache.getStatistics().missCount == 4u);
+    }
+
+    SECTION("Clearing keeps statistics")
+    {
+        (void)dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 6u, 4u }, mesh, cache);
+        cache.clear();
+        (void)dgm::TileNavMesh::computePath(
+            { 1u, 1u }, { 6u, 4u }, mesh, cache);
+
+        REQUIRE(cache.getStatistics().missCount == 2u);
+        cache.resetStatistics();
+        REQUIRE(cache.getStatistics().missCount == 0u);
+    }
+
+    SECTION("WorldNavMesh")
+    {
+        auto navmesh = dgm::WorldNavMesh(mesh.clone());
+        auto worldCache = dgm::PathCache<dgm::WorldNavpoint>();
+
+        SECTION("Points within the same tiles share the result")
+        {
+            auto path1 = navmesh.computePath(
+                { 40.f, 40.f }, { 200.f, 140.f }, worldCache);
+            auto path2 = navmesh.computePath(
+                { 50.f, 60.f }, { 210.f, 150.f }, worldCache);
+
+            REQUIRE(worldCache.getStatistics().hitCount == 1u);
+            requireSamePaths(
+                std::optional(std::move(path1)),
+                std::optional(std::move(path2)));
+        }
+
+        SECTION("Applying changes invalidates the cache")
+        {
+            REQUIRE(navmesh
+                        .computePath(
+                            { 40.f, 40.f }, { 272.f, 48.f }, worldCache)
+                        .isTraversed());
+
+            navmesh.setTile({ 7u, 2u }, 0);
+            navmesh.applyChanges();
+
+            REQUIRE_FALSE(navmesh
+                              .computePath(
+                                  { 40.f, 40.f }, { 272.f, 48.f }, worldCache)
+                              .isTraversed());
+            REQUIRE(worldCache.getStatistics().invalidationCount == 1u);
+        }
+    }
+}
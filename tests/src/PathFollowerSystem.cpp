@@ -0,0 +1,160 @@
+#include <DGM/classes/Error.hpp>
+#include <DGM/classes/PathFollowerSystem.hpp>
+#include <catch2/catch_all.hpp>
+
+class TestableTime_PathFollower : public dgm::Time
+{
+public:
+    TestableTime_PathFollower(float dt)
+    {
+        deltaTime = dt;
+    }
+};
+
+static void
+requirePosition(const sf::Vector2f& actual, const sf::Vector2f& expected)
+{
+    REQUIRE_THAT(actual.x, Catch::Matchers::WithinAbs(expected.x, 0.001f));
+    REQUIRE_THAT(actual.y, Catch::Matchers::WithinAbs(expected.y, 0.001f));
+}
+
+TEST_CASE("[PathFollowerSystem]")
+{
+    using AgentId = dgm::PathFollowerSystem::AgentId;
+
+    const auto second = TestableTime_PathFollower(1.f);
+    auto system = dgm::PathFollowerSystem();
+    const auto path = dgm::Path<dgm::WorldNavpoint>(
+        { dgm::WorldNavpoint { { 10.f, 0.f } },
+          dgm::WorldNavpoint { { 10.f, 10.f } },
+          dgm::WorldNavpoint { { 0.f, 10.f } } },
+        false);
+
+    SECTION("Agent follows the path and its arrival is reported once")
+    {
+        const AgentId id = system.addAgent({ 0.f, 0.f }, 4.f);
+        system.setPath(id, path);
+        REQUIRE(system.isMoving(id));
+
+        REQUIRE(system.update(second).empty());
+        requirePosition(system.getPosition(id), { 4.f, 0.f });
+
+        // Movement left after reaching a waypoint is not lost
+        REQUIRE(system.update(second).empty());
+        REQUIRE(system.update(second).empty());
+        requirePosition(system.getPosition(id), { 10.f, 2.f });
+
+        for (unsigned i = 0; i < 4; ++i)
+            REQUIRE(system.update(second).empty());
+        const auto arrivals = system.update(second);
+        REQUIRE(arrivals.size() == 1u);
+        REQUIRE(arrivals[0] == id);
+        requirePosition(system.getPosition(id), { 0.f, 10.f });
+        REQUIRE_FALSE(system.isMoving(id));
+
+        REQUIRE(system.update(second).empty());
+        requirePosition(system.getPosition(id), { 0.f, 10.f });
+    }
+
+    SECTION("Agent starts from the current point of the path")
+    {
+        auto advancedPath = path.clone();
+        advancedPath.advance();
+
+        const AgentId id = system.addAgent({ 10.f, 0.f }, 5.f);
+        system.setPath(id, advancedPath);
+        (void)system.update(second);
+        requirePosition(system.getPosition(id), { 10.f, 5.f });
+        REQUIRE(path.getSharedPoints().use_count() == 3);
+    }
+
+    SECTION("Fast agent passes several waypoints in one update")
+    {
+        const AgentId id = system.addAgent({ 0.f, 0.f }, 25.f);
+        system.setPath(id, path);
+        requirePosition(system.getPosition(id), { 0.f, 0.f });
+
+        (void)system.update(second);
+        requirePosition(system.getPosition(id), { 5.f, 10.f });
+    }
+
+    SECTION("Looping path is never finished")
+    {
+        const AgentId id = system.addAgent({ 0.f, 0.f }, 100.f);
+        system.setPath(
+            id,
+            dgm::Path<dgm::WorldNavpoint>(
+                { dgm::WorldNavpoint { { 0.f, 0.f } } }, true));
+
+        for (unsigned i = 0; i < 3; ++i)
+            REQUIRE(system.update(second).empty());
+        REQUIRE(system.isMoving(id));
+        requirePosition(system.getPosition(id), { 0.f, 0.f });
+    }
+
+    SECTION("Idle and stopped agents do not move")
+    {
+        const AgentId idle = system.addAgent({ 1.f, 2.f }, 10.f);
+        const AgentId stopped = system.addAgent({ 0.f, 0.f }, 4.f);
+        system.setPath(stopped, path);
+        (void)system.update(second);
+        system.stop(stopped);
+
+        system.setPosition(idle, { 3.f, 3.f });
+        REQUIRE(system.update(second).empty());
+        requirePosition(system.getPosition(idle), { 3.f, 3.f });
+        requirePosition(system.getPosition(stopped), { 4.f, 0.f });
+    }
+
+    SECTION("Removed ids are reused")
+    {
+        const AgentId a = system.addAgent({ 0.f, 0.f }, 1.f);
+        const AgentId b = system.addAgent({ 0.f, 0.f }, 1.f);
+        system.setPath(a, path);
+        system.removeAgent(a);
+        system.removeAgent(a);
+        REQUIRE(system.getAgentCount() == 1u);
+        REQUIRE(path.getSharedPoints().use_count() == 1);
+
+        REQUIRE_THROWS_AS(system.getPosition(a), dgm::Exception);
+        REQUIRE_THROWS_AS(system.setPath(123u, path), dgm::Exception);
+
+        REQUIRE(system.addAgent({ 5.f, 5.f }, 1.f) == a);
+        REQUIRE_FALSE(system.isMoving(a));
+        requirePosition(system.getPosition(a), { 5.f, 5.f });
+        REQUIRE(system.getAgentCount() == 2u);
+        REQUIRE(b != a);
+    }
+
+    SECTION("Agents sharing points move independently")
+    {
+        std::vector<AgentId> ids;
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            ids.push_back(
+                system.addAgent({ 0.f, 0.f }, 1.f + static_cast<float>(i)));
+            system.setPath(ids.back(), path);
+        }
+        REQUIRE(path.getSharedPoints().use_count() == 101);
+
+        std::vector<unsigned> arrivalFrames(ids.size(), 0u);
+        std::size_t arrivalCount = 0;
+        for (unsigned frame = 1; frame <= 30; ++frame)
+        {
+            for (auto&& id : system.update(second))
+            {
+                arrivalFrames[id] = frame;
+                ++arrivalCount;
+            }
+        }
+
+        // Faster agents arrive sooner
+        REQUIRE(arrivalCount == ids.size());
+        REQUIRE(arrivalFrames.front() == 30u);
+        REQUIRE(arrivalFrames.back() == 1u);
+        for (std::size_t i = 1; i < ids.size(); ++i)
+            REQUIRE(arrivalFrames[i - 1] >= arrivalFrames[i]);
+        for (auto&& id : ids)
+            requirePosition(system.getPosition(id), { 0.f, 10.f });
+    }
+}
@@ -0,0 +1,185 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/Error.hpp>
+#include <DGM/classes/NavMesh.hpp>
+#include <DGM/classes/PathSearchScheduler.hpp>
+#include <catch2/catch_all.hpp>
+
+[[nodiscard]] static dgm::Mesh buildMeshForPathSearchTesting()
+{
+    // Bordered 48x40 map with walls that have gaps, some random noise
+    // generated from a fixed seed and a wall-locked pocket in the corner
+    const sf::Vector2u size = { 48u, 40u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(7u);
+    for (unsigned y = 0; y < size.y; ++y)
+    {
+        for (unsigned x = 0; x < size.x; ++x)
+        {
+            const bool border =
+                x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            const bool wall = x % 12 == 6 && y % 15 != 7;
+            const bool pocket = (x == 43 || y == 35) && x >= 43 && y >= 35;
+            const bool noise = random.oneIn(8u);
+            mesh[{ x, y }] = border || wall || pocket || noise ? 1 : 0;
+        }
+    }
+    mesh[{ 45u, 37u }] = 0;
+    return mesh;
+}
+
+static void requireSamePaths(
+    std::optional<dgm::Path<dgm::TileNavpoint>> a,
+    std::optional<dgm::Path<dgm::TileNavpoint>> b)
+{
+    REQUIRE(a.has_value() == b.has_value());
+    if (!a) return;
+
+    REQUIRE(a->getLength() == b->getLength());
+    while (!a->isTraversed())
+    {
+        REQUIRE(a->getCurrentPoint().coord == b->getCurrentPoint().coord);
+        a->advance();
+        b->advance();
+    }
+}
+
+TEST_CASE("[PathSearch]")
+{
+    using Status = dgm::TileNavMesh::PathSearch::Status;
+    using SearchOptions = dgm::TileNavMesh::SearchOptions;
+    using SearchAlgorithm = dgm::TileNavMesh::SearchAlgorithm;
+    using Connectivity = dgm::TileNavMesh::Connectivity;
+
+    const auto mesh = buildMeshForPathSearchTesting();
+
+    SECTION("Stepping yields the same path as computePath")
+    {
+        for (auto&& options :
+             { SearchOptions {},
+               SearchOptions { .connectivity = Connectivity::EightWay },
+               SearchOptions {
+                   .algorithm = SearchAlgorithm::JumpPointSearch,
+                   .connectivity = Connectivity::EightWay } })
+        {
+            for (unsigned i = 0; i < 20; ++i)
+            {
+                const auto from = sf::Vector2u(
+                    1u + (i * 5u) % 40u, 1u + (i * 7u) % 30u);
+                const auto to = sf::Vector2u(
+                    46u - (i * 3u) % 40u, 38u - (i * 11u) % 30u);
+                if (mesh[from] > 0 || mesh[to] > 0) continue;
+
+                auto search = dgm::TileNavMesh::PathSearch(
+                    from, to, mesh, options);
+                std::size_t stepCount = 0;
+                while (!search.isFinished())
+                {
+                    REQUIRE(search.getPath() == std::nullopt);
+                    REQUIRE(search.step(3u) <= 3u);
+                    ++stepCount;
+                }
+
+                REQUIRE(search.getExpandedNodeCount() <= stepCount * 3u);
+                REQUIRE(search.step(3u) == 0u);
+                requireSamePaths(
+                    search.getPath(),
+                    dgm::TileNavMesh::computePath(from, to, mesh, options));
+            }
+        }
+    }
+
+    SECTION("Search reports unreachable destination")
+    {
+        auto search =
+            dgm::TileNavMesh::PathSearch({ 2u, 2u }, { 45u, 37u }, mesh);
+        REQUIRE(search.getStatus() == Status::InProgress);
+
+        while (!search.isFinished())
+            (void)search.step(100u);
+
+        REQUIRE(search.getStatus() == Status::Unreachable);
+        REQUIRE_FALSE(search.getPath());
+    }
+
+    SECTION("Trivial searches finish immediately")
+    {
+        auto fromWall =
+            dgm::TileNavMesh::PathSearch({ 0u, 0u }, { 2u, 2u }, mesh);
+        REQUIRE(fromWall.getStatus() == Status::Unreachable);
+        REQUIRE(fromWall.step(10u) == 0u);
+
+        auto identity =
+            dgm::TileNavMesh::PathSearch({ 2u, 2u }, { 2u, 2u }, mesh);
+        REQUIRE(identity.getStatus() == Status::Found);
+        REQUIRE(identity.getPath()->isTraversed());
+    }
+}
+
+TEST_CASE("[PathSearchScheduler]")
+{
+    using Status = dgm::PathSearchScheduler::Status;
+
+    const auto mesh = buildMeshForPathSearchTesting();
+    auto scheduler = dgm::PathSearchScheduler(50u);
+
+    std::vector<std::pair<sf::Vector2u, sf::Vector2u>> queries;
+    for (unsigned i = 0; i < 12; ++i)
+    {
+        const auto from =
+            sf::Vector2u(1u + (i * 13u) % 44u, 1u + (i * 7u) % 36u);
+        const auto to =
+            sf::Vector2u(45u - (i * 5u) % 44u, 37u - (i * 3u) % 36u);
+        if (mesh[from] <= 0 && mesh[to] <= 0) queries.emplace_back(from, to);
+    }
+    REQUIRE(queries.size() > 4u);
+
+    std::vector<dgm::PathSearchScheduler::SearchId> ids;
+    for (auto&& [from, to] : queries)
+        ids.push_back(
+            scheduler.enqueue(dgm::TileNavMesh::PathSearch(from, to, mesh)));
+
+    SECTION("Budget is never exceeded and all searches finish")
+    {
+        REQUIRE(scheduler.getPendingCount() == queries.size());
+
+        while (scheduler.getPendingCount() > 0)
+            REQUIRE(scheduler.update() <= 50u);
+        REQUIRE(scheduler.update() == 0u);
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            REQUIRE(scheduler.getStatus(ids[i]) != Status::InProgress);
+            requireSamePaths(
+                scheduler.takePath(ids[i]),
+                dgm::TileNavMesh::computePath(
+                    queries[i].first, queries[i].second, mesh));
+        }
+    }
+
+    SECTION("Budget is shared by all pending searches")
+    {
+        (void)scheduler.update();
+        for (auto&& id : ids)
+            REQUIRE(scheduler.getStatus(id) == Status::InProgress);
+    }
+
+    SECTION("Unfinished search is kept by takePath")
+    {
+        REQUIRE_FALSE(scheduler.takePath(ids.front()));
+        REQUIRE(scheduler.getStatus(ids.front()) == Status::InProgress);
+    }
+
+    SECTION("Taken and cancelled searches are forgotten")
+    {
+        while (scheduler.getPendingCount() > 0)
+            (void)scheduler.update();
+
+        (void)scheduler.takePath(ids[0]);
+        scheduler.cancel(ids[1]);
+        scheduler.cancel(12345u);
+
+        REQUIRE_THROWS_AS(scheduler.getStatus(ids[0]), dgm::Exception);
+        REQUIRE_THROWS_AS(scheduler.takePath(ids[1]), dgm::Exception);
+        REQUIRE(scheduler.getStatus(ids[2]) != Status::InProgress);
+    }
+}
@@ -0,0 +1,73 @@
+#include <DGM/classes/PathfindingContext.hpp>
+#include <catch2/catch_all.hpp>
+
+TEST_CASE("[PathfindingContext]")
+{
+    auto context = dgm::PathfindingContext({ 4u, 4u });
+    context.beginSearch({ 4u, 4u });
+
+    SECTION("Converts between coords and indices")
+    {
+        REQUIRE(context.toIndex({ 3u, 2u }) == 11u);
+        REQUIRE(context.toCoord(11u) == sf::Vector2u(3u, 2u));
+    }
+
+    SECTION("Pops nodes ordered by fcost, hcost and index")
+    {
+        context.openNode(7u, 4u, 2u, 0u);
+        context.openNode(3u, 1u, 5u, 0u);
+        context.openNode(9u, 2u, 1u, 0u);
+        context.openNode(5u, 4u, 2u, 0u);
+        context.openNode(1u, 3u, 2u, 0u);
+
+        REQUIRE(context.popBestNode() == 9u);
+        REQUIRE(context.popBestNode() == 1u);
+        REQUIRE(context.popBestNode() == 5u);
+        REQUIRE(context.popBestNode() == 7u);
+        REQUIRE(context.popBestNode() == 3u);
+        REQUIRE_FALSE(context.hasOpenNodes());
+    }
+
+    SECTION("Decreases key of an open node")
+    {
+        context.openNode(5u, 10u, 1u, 0u);
+        context.openNode(6u, 5u, 1u, 0u);
+
+        REQUIRE_FALSE(context.openNode(5u, 11u, 1u, 2u));
+        REQUIRE(context.getParent(5u) == 0u);
+
+        REQUIRE(context.openNode(5u, 1u, 1u, 2u));
+        REQUIRE(context.getGcost(5u) == 1u);
+        REQUIRE(context.getParent(5u) == 2u);
+        REQUIRE(context.popBestNode() == 5u);
+    }
+
+    SECTION("Closed nodes are never reopened")
+    {
+        context.openNode(5u, 10u, 1u, 0u);
+        REQUIRE(context.popBestNode() == 5u);
+        REQUIRE(context.isClosed(5u));
+        REQUIRE_FALSE(context.openNode(5u, 1u, 1u, 0u));
+        REQUIRE_FALSE(context.hasOpenNodes());
+    }
+
+    SECTION("Starting new search forgets all nodes")
+    {
+        context.openNode(5u, 10u, 1u, 0u);
+        context.openNode(6u, 10u, 1u, 0u);
+        REQUIRE(context.popBestNode() == 5u);
+
+        context.beginSearch({ 4u, 4u });
+        REQUIRE_FALSE(context.hasOpenNodes());
+        REQUIRE_FALSE(context.isClosed(5u));
+        REQUIRE_FALSE(context.isOpen(6u));
+    }
+
+    SECTION("Grows for bigger meshes")
+    {
+        context.beginSearch({ 8u, 8u });
+        REQUIRE(context.toIndex({ 7u, 7u }) == 63u);
+        REQUIRE(context.openNode(63u, 0u, 0u, 63u));
+        REQUIRE(context.isOpen(63u));
+    }
+}
@@ -0,0 +1,97 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/SummedAreaTable.hpp>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+
+[[nodiscard]] static std::uint32_t countSolidTilesByScan(
+    const dgm::Mesh& mesh,
+    const sf::Vector2u& topLeft,
+    const sf::Vector2u& bottomRight)
+{
+    std::uint32_t count = 0;
+    for (unsigned y = topLeft.y; y <= bottomRight.y; ++y)
+    {
+        for (unsigned x = topLeft.x; x <= bottomRight.x; ++x)
+            count += mesh[{ x, y }] > 0 ? 1u : 0u;
+    }
+    return count;
+}
+
+static void
+requireSameCounts(const dgm::SummedAreaTable& table, const dgm::Mesh& mesh)
+{
+    const auto size = mesh.getDataSize();
+    REQUIRE(table.getDataSize() == size);
+
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        const auto topLeft =
+            sf::Vector2u((i * 13u) % size.x, (i * 7u) % size.y);
+        const auto bottomRight = sf::Vector2u(
+            topLeft.x + (i * 5u) % (size.x - topLeft.x),
+            topLeft.y + (i * 11u) % (size.y - topLeft.y));
+
+        const auto expected = countSolidTilesByScan(mesh, topLeft, bottomRight);
+        REQUIRE(table.countSolidTiles(topLeft, bottomRight) == expected);
+        REQUIRE(table.hasSolidTile(topLeft, bottomRight) == (expected > 0));
+    }
+}
+
+TEST_CASE("[SummedAreaTable]")
+{
+    const sf::Vector2u size = { 45u, 32u };
+    auto mesh = dgm::Mesh(size, { 16u, 16u });
+    auto random = SeededRandom(21u);
+
+    for (auto&& tile : mesh.getRawData())
+        tile = random(4u) == 0u ? 1 : 0;
+    auto table = dgm::SummedAreaTable(mesh);
+
+    SECTION("Counts match tile by tile scan")
+    {
+        requireSameCounts(table, mesh);
+        REQUIRE(
+            table.countSolidTiles({ 0u, 0u }, size - sf::Vector2u(1u, 1u))
+            == countSolidTilesByScan(
+                mesh, { 0u, 0u }, size - sf::Vector2u(1u, 1u)));
+    }
+
+    SECTION("Single tile edits")
+    {
+        for (unsigned round = 0; round < 100; ++round)
+        {
+            const auto tile = sf::Vector2u(random(size.x), random(size.y));
+            mesh.setTile(tile, mesh[tile] > 0 ? 0 : 2);
+            table.update(mesh, tile);
+            REQUIRE(table.getMeshVersion() == mesh.getVersion());
+            REQUIRE(table.hasSolidTile(tile, tile) == (mesh[tile] > 0));
+        }
+        requireSameCounts(table, mesh);
+    }
+
+    SECTION("Rectangle edits")
+    {
+        for (unsigned round = 0; round < 50; ++round)
+        {
+            const auto topLeft = sf::Vector2u(random(size.x), random(size.y));
+            const auto bottomRight = topLeft + sf::Vector2u(4u, 3u);
+            for (unsigned y = topLeft.y; y <= std::min(bottomRight.y, 31u); ++y)
+            {
+                for (unsigned x = topLeft.x;
+                     x <= std::min(bottomRight.x, 44u);
+                     ++x)
+                    mesh.setTile({ x, y }, random(2u) == 0u ? 1 : -1);
+            }
+            table.update(mesh, topLeft, bottomRight);
+        }
+        requireSameCounts(table, mesh);
+    }
+
+    SECTION("Resized mesh is summed again")
+    {
+        mesh.setDataSize(10u, 20u);
+        mesh.setTile({ 9u, 19u }, 1);
+        table.update(mesh, { 9u, 19u });
+        requireSameCounts(table, mesh);
+    }
+}
@@ -0,0 +1,145 @@
+#include "SeededRandom.hpp"
+#include <DGM/classes/SpatialIndex.hpp>
+#include <DGM/classes/SweepAndPrune.hpp>
+#include <catch2/catch_all.hpp>
+
+using PairList = dgm::SweepAndPrune<>::PairListType;
+
+[[nodiscard]] static PairList sorted(PairList pairs)
+{
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+TEST_CASE("[SweepAndPrune]")
+{
+    auto broadphase = dgm::SweepAndPrune<>();
+    broadphase.returnToLookup(0u, dgm::Rect({ 0.f, 0.f }, { 10.f, 10.f }));
+    broadphase.returnToLookup(1u, dgm::Circle({ 12.f, 5.f }, 3.f));
+    broadphase.returnToLookup(2u, dgm::Rect({ 100.f, 0.f }, { 5.f, 5.f }));
+    broadphase.returnToLookup(3u, sf::Vector2f(5.f, 9.f));
+
+    SECTION("Reports pairs of overlapping boxes")
+    {
+        REQUIRE(broadphase.size() == 4u);
+        REQUIRE(
+            sorted(broadphase.getCandidatePairs())
+            == PairList { { 0u, 1u }, { 0u, 3u } });
+    }
+
+    SECTION("Boxes are only tested against each other along Y axis")
+    {
+        // Overlaps with 0 along X, but is far below it
+        broadphase.returnToLookup(
+            4u, dgm::Rect({ 2.f, 50.f }, { 100.f, 1.f }));
+        REQUIRE(
+            sorted(broadphase.getCandidatePairs())
+            == PairList { { 0u, 1u }, { 0u, 3u } });
+    }
+
+    SECTION("Moving an item updates pairs")
+    {
+        broadphase.update(2u, dgm::Rect({ 8.f, 8.f }, { 5.f, 5.f }));
+        broadphase.update(1u, dgm::Circle({ 120.f, 5.f }, 3.f));
+        REQUIRE(
+            sorted(broadphase.getCandidatePairs())
+            == PairList { { 0u, 2u }, { 0u, 3u } });
+    }
+
+    SECTION("Removed item is not reported")
+    {
+        broadphase.removeFromLookup(0u, dgm::Rect({}, {}));
+        REQUIRE_FALSE(broadphase.contains(0u));
+        REQUIRE(broadphase.getCandidatePairs().empty());
+        REQUIRE(
+            broadphase.getOverlapCandidates(sf::Vector2f(5.f, 9.f))
+            == std::vector<std::size_t> { 3u });
+
+        broadphase.returnToLookup(0u, dgm::Rect({ 0.f, 0.f }, { 10.f, 10.f }));
+        REQUIRE(broadphase.getCandidatePairs().size() == 2u);
+    }
+
+    SECTION("Update inserts items that are not in the lookup yet")
+    {
+        auto fresh = dgm::SweepAndPrune<>();
+        fresh.update(5u, dgm::Rect({ 0.f, 0.f }, { 10.f, 10.f }));
+        fresh.update(2u, dgm::Circle({ 12.f, 5.f }, 3.f));
+        REQUIRE(fresh.contains(5u));
+        REQUIRE(fresh.getCandidatePairs() == PairList { { 2u, 5u } });
+
+        broadphase = std::move(fresh);
+        REQUIRE(broadphase.size() == 2u);
+        REQUIRE_FALSE(broadphase.contains(0u));
+    }
+
+    SECTION("Querying a box")
+    {
+        auto candidates = broadphase.getOverlapCandidates(
+            dgm::Rect({ 9.f, -5.f }, { 1.f, 30.f }));
+        std::sort(candidates.begin(), candidates.end());
+        REQUIRE(candidates == std::vector<std::size_t> { 0u, 1u });
+
+        // Wide box reaches the query from far away
+        broadphase.returnToLookup(
+            7u, dgm::Rect({ -500.f, 0.f }, { 1000.f, 1.f }));
+        candidates = broadphase.getOverlapCandidates(sf::Vector2f(103.f, 1.f));
+        std::sort(candidates.begin(), candidates.end());
+        REQUIRE(candidates == std::vector<std::size_t> { 2u, 7u });
+    }
+}
+
+TEST_CASE("Sweep and prune matches brute force", "[SweepAndPrune]")
+{
+    auto random = SeededRandom(17u);
+
+    constexpr std::size_t COUNT = 200;
+    auto boxes = std::vector<dgm::Rect> {};
+    auto broadphase = dgm::SweepAndPrune<>();
+    auto grid =
+        dgm::SpatialIndex<>(dgm::Rect({ 0.f, 0.f }, { 500.f, 500.f }), 8);
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        // Mostly small boxes with a few huge ones
+        const float size =
+            i % 20 == 0 ? 100.f + random(100u) : 1.f + random(10u);
+        boxes.emplace_back(
+            sf::Vector2f(random(400u), random(400u)),
+            sf::Vector2f(size, 1.f + random(10u)));
+        broadphase.returnToLookup(i, boxes.back());
+        grid.returnToLookup(i, boxes.back());
+    }
+
+    auto bruteForce = [&]
+    {
+        auto pairs = PairList {};
+        for (std::size_t i = 0; i < COUNT; ++i)
+        {
+            for (std::size_t j = i + 1; j < COUNT; ++j)
+            {
+                if (dgm::Collision::basic(boxes[i], boxes[j]))
+                    pairs.emplace_back(i, j);
+            }
+        }
+        return pairs;
+    };
+
+    for (unsigned frame = 0; frame < 10; ++frame)
+    {
+        const auto expected = bruteForce();
+        REQUIRE(sorted(broadphase.getCandidatePairs()) == expected);
+
+        // Every overlapping pair shares a cell of the grid
+        const auto gridPairs = grid.getCandidatePairs();
+        for (auto&& pair : expected)
+            REQUIRE(std::binary_search(
+                gridPairs.begin(), gridPairs.end(), pair));
+
+        for (std::size_t i = 0; i < COUNT; ++i)
+        {
+            grid.removeFromLookup(i, boxes[i]);
+            boxes[i].move({ random(21u) - 10.f, random(7u) - 3.f });
+            broadphase.update(i, boxes[i]);
+            grid.returnToLookup(i, boxes[i]);
+        }
+    }
+}